@@ -11,13 +11,20 @@
 #include "adc_app.h"
 
 #include "adConv1.h"
+#include "adc_filter.h"
+#include "adc_capture.h"
+#include "current_ctrl.h"
+#include "edma_driver.h"
 #include "sfl_math.h"
 #include "io_tables.h"
 #include "hal_io.h"
+#include "hal_tick.h"
 #include "adc_app.h"
 #include "user_api_io.h"
 #include "modulhardwarecode.h"
 #include "ftm_app.h"
+#include "sched_app.h"
+#include "prof_app.h"
 
 #include "defines_general.h"
 // The following header should be included first
@@ -32,6 +39,46 @@
 // ===================================================================================================
 #define NEW_PDB_CODE 1  // used to switch to new pdb_init() that iterates through a table rather than having individual lines of code for each pdb
 
+#if ADC_DMA_RESULTS
+#define ADC_DMA_CHN_ADCONV1         (3u)                    // eDMA channel of ADC0 results. Channels 1 and 2 are configured by dmaController1 (SCI).
+#define ADC_DMA_CHN_ADCONV2         (4u)                    // eDMA channel of ADC1 results.
+#define ADC_DMA_RESULT_N            ADC_CTRL_CHANS_COUNT    // result registers per ADC instance
+#define ADC_DMA_BUFFER_N            (2u)                    // double buffer: one is written by the eDMA while the other one is read
+
+#if defined(ADC_aR_COUNT)
+#define ADC_DMA_RESULT_REG(base)    (&(base)->aR[0])        // S32K148: 32 result registers in the alias area
+#else
+#define ADC_DMA_RESULT_REG(base)    (&(base)->R[0])
+#endif
+
+#define ADC_RESULT_IRQN_ADCONV1     ((IRQn_Type)((uint32_t)DMA0_IRQn + ADC_DMA_CHN_ADCONV1))
+#define ADC_RESULT_IRQN_ADCONV2     ((IRQn_Type)((uint32_t)DMA0_IRQn + ADC_DMA_CHN_ADCONV2))
+#else
+#define ADC_RESULT_IRQN_ADCONV1     ADC0_IRQn
+#define ADC_RESULT_IRQN_ADCONV2     ADC1_IRQn
+#endif
+
+
+#define ADC_MUX_GROUP_N             (8u)    // multiplex groups selectable by modulhardwarecode_adc_multiplex
+#define ADC_MUX_PIN_A               DO_MUX_A_ANA    // select lines of the multiplexer, group = C*4 + B*2 + A (see modulhardwarecode_adc_multiplex)
+#define ADC_MUX_PIN_B               DO_MUX_B_ANA
+#define ADC_MUX_PIN_C               DO_MUX_C_ANA
+#define ADC_MUX_IDLE_PERIOD_MS      (1000u) // refresh period of groups which haven't been read within their idle timeout
+#define ADC_MUX_RATE_WINDOW_MS      (1000u) // measurement window of the achieved refresh rates
+
+#define ADC_FRAME_BUFFER_N          (2u)    // published frames: the last one is read while the next one is written
+#define ADC_FRAME_BARRIER()         __asm volatile ("dmb" : : : "memory")   // frame data is written before its sequence number and read in front of the check
+
+#ifndef ADC_ACQ_PROFILE_DEFAULT
+#define ADC_ACQ_PROFILE_DEFAULT     ADC_ACQ_PROFILE_STANDARD    // profile set by ADC_init
+#endif
+
+#if (defined(S32K148))
+#define ADC_PDB_CHN_N               (4u)    // PDB channels with a pre-trigger delay, each one starts a chain of conversions
+#else
+#define ADC_PDB_CHN_N               (2u)
+#endif
+#define ADC_PDB_DELAY_DIV           (4u)    // the PDB channels start at quarters of the PDB cycle
 
 #define CALIBR_MAX_ADC_VAL          (4095u)
 #define CALIBR_MAX_VOLT_VAL         (5000u)
@@ -48,7 +95,63 @@
 
 #define CALIB_VAL_SIZE     ( (CALIB_POINTS_SOURCE + CALIB_POINTS_SINK) * CALIB_PAIR * sizeof(CALIB_DATA_TYPE) )
 
+#define ADC_CAL_SEGMENT_N       (CALIB_POINTS_SOURCE - 1)   // straight lines between the source points
+#define ADC_CAL_SLOPE_SHIFT     (16u)                       // fractional bits of the slope
+#define ADC_CAL_RAW_N           (CALIB_POINTS_SOURCE * CALIB_PAIR)  // words of a table used by the segments
+#define ADC_CAL_CHECK_PER_CALL  (4u)                        // channels whose table adc_processing compares with the EEPROM per call
+
 FILENUM(89)   ///< This is to ease the tracking of assert failures. Each file should have its own unique file number.
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+typedef struct
+{
+    uint8_t result_index;       // index in adc_config_tbl / adc_results
+    uint8_t adc_channel;        // control channel of the ADC instance
+    uint8_t source_index;       // index in adc_interrupt_values which holds the register value of adc_channel
+} struct_adc_chan_ref_t;
+
+typedef enum
+{
+    ADC_CAL_STATE_EMPTY         = 0u,   // no calibration values in the EEPROM
+    ADC_CAL_STATE_UNSUPPORTED       ,   // calibration type not handled, result_cal is 0
+    ADC_CAL_STATE_VALID                 // segments loaded
+} enum_adc_cal_state_t;
+
+typedef struct
+{
+    int16_t x;                  // start of the segment (left support point)
+    int16_t y;                  // value at x
+    int32_t slope;              // dy/dx with ADC_CAL_SLOPE_SHIFT fractional bits
+} struct_adc_cal_segment_t;
+
+typedef struct
+{
+    struct_adc_cal_segment_t seg[ADC_CAL_SEGMENT_N];
+    int16_t x_upper[ADC_CAL_SEGMENT_N];     // segment k is used up to and including x_upper[k], the last segment extrapolates upwards
+    uint8_t state;                          // enum_adc_cal_state_t
+} struct_adc_cal_cache_t;
+
+typedef struct
+{
+    uint32_t sum;               // sum of the results of the current oversampling window
+    uint16_t cnt;               // results in sum
+    uint8_t  bits;              // extra bits, window of 4^bits PDB cycles, 0 = off
+    uint16_t result;            // last decimated result with 12 + bits bit
+} struct_adc_oversampling_t;
+
+typedef struct
+{
+    uint8_t  priority;          // higher value wins if several groups are due
+    uint16_t period_ms;         // target refresh period, 0 = always due
+    uint16_t idle_timeout_ms;   // group is refreshed only every ADC_MUX_IDLE_PERIOD_MS if none of its channels has been read for this time, 0 = never idle
+    uint32_t last_refresh_ms;   // time of the last refresh
+    uint32_t last_refresh_seq;  // number of the last refresh over all groups, the oldest one is taken between due groups of the same priority
+    uint32_t last_read_ms;      // time of the last read of one of the channels
+    uint32_t refresh_cnt;       // refreshes in the current rate window
+    uint32_t refresh_rate_mhz;  // achieved refreshes per 1000 s in the last rate window
+} struct_adc_mux_group_t;
 // ===================================================================================================
 // Global data definitions
 // ===================================================================================================
@@ -59,7 +162,52 @@ uint16_t adc_interrupt_values[ADC_MAX] = {0};
 
 uint8_t mgl_multiplex_group_max = 0u;
 
-uint32_t mgl_adc_counter[ADC_INSTANCE_COUNT] = {0}; //global ADC counter, which is incremented each time the ADC interrupt is processed.
+// channel lists built by adc_build_channel_index()
+static struct_adc_chan_ref_t mgl_adc_chan_ref[ADC_MAX];             // all channels, grouped by ADC instance
+static uint8_t mgl_adc_chan_first[ADC_INSTANCE_COUNT + 1u];         // first entry of each instance in mgl_adc_chan_ref, last element = number of entries
+static uint8_t mgl_adc_chan_read_end[ADC_INSTANCE_COUNT];           // entries in front of this one are read from the ADC (one per control channel), the rest share their register
+static uint8_t mgl_adc_direct_idx[ADC_MAX];                         // result indices of the not multiplexed channels
+static uint8_t mgl_adc_direct_cnt = 0u;                             // number of entries in mgl_adc_direct_idx
+static uint8_t mgl_adc_mux_idx[ADC_MAX];                            // result indices of the multiplexed channels, grouped by multiplex group
+static uint8_t mgl_adc_mux_first[ADC_MUX_GROUP_N + 1u];             // first entry of each multiplex group in mgl_adc_mux_idx, last element = number of entries
+
+volatile uint32_t mgl_adc_counter[ADC_INSTANCE_COUNT] = {0}; //global ADC counter, which is incremented each time the ADC interrupt is processed.
+
+static struct_adc_cal_cache_t mgl_adc_cal[ADC_MAX];                 // calibration tables of the EEPROM converted to segments, see adc_cal_cache_load()
+static int16_t mgl_adc_cal_raw[ADC_MAX][ADC_CAL_RAW_N];            // EEPROM words of the tables at the last load, see adc_cal_cache_check()
+
+// acquisition profiles, the moduli scale the standard PDB cycle with the number of averaged conversions
+static const struct_adc_acq_profile_t mgl_adc_acq_profile_tbl[ADC_ACQ_PROFILE_MAX] =
+{
+    // hw_avg_enable, hw_avg,          pdb_modulus
+    {  false,         ADC_AVERAGE_4,   4000u  },    // ADC_ACQ_PROFILE_STANDARD
+    {  true,          ADC_AVERAGE_4,   16000u },    // ADC_ACQ_PROFILE_HWAVG_4
+    {  true,          ADC_AVERAGE_8,   32000u },    // ADC_ACQ_PROFILE_HWAVG_8
+    {  true,          ADC_AVERAGE_16,  64000u },    // ADC_ACQ_PROFILE_HWAVG_16
+};
+static uint8_t mgl_adc_acq_profile = ADC_ACQ_PROFILE_DEFAULT;
+
+static struct_adc_oversampling_t mgl_adc_os[ADC_MAX];              // oversampling of the channels, written in the frame interrupt
+static uint8_t mgl_adc_os_ref[ADC_MAX];                             // mgl_adc_chan_ref entries with oversampling, grouped by ADC instance
+static uint8_t mgl_adc_os_first[ADC_INSTANCE_COUNT + 1u];           // first entry of each instance in mgl_adc_os_ref, last element = number of entries
+
+static struct_adc_mux_group_t mgl_adc_mux_grp[ADC_MUX_GROUP_N];     // scheduling of the multiplex groups, see adc_mux_schedule()
+static volatile uint8_t mgl_adc_mux_read[ADC_MUX_GROUP_N];          // set by adc_mux_touch, taken over by adc_mux_schedule
+static uint32_t mgl_adc_mux_refresh_seq = 0u;
+static uint32_t mgl_adc_mux_rate_start_ms = 0u;
+static GPIO_Type *mgl_adc_mux_gpio = NULL;                          // port of all select lines, NULL: modulhardwarecode_adc_multiplex sets them
+static uint32_t mgl_adc_mux_mask = 0u;                              // select lines in mgl_adc_mux_gpio
+static uint32_t mgl_adc_mux_pattern[ADC_MUX_GROUP_N];               // output value of the select lines of each group
+
+static struct_adc_frame_t mgl_adc_frame[ADC_FRAME_BUFFER_N];       // frames published by adc_processing, see adc_frame_publish()
+static volatile uint32_t mgl_adc_frame_seq = 0u;                    // sequence number of the last published frame, 0 = none yet
+
+#if ADC_DMA_RESULTS
+static edma_chn_state_t mgl_adc_dma_chn_state[ADC_INSTANCE_COUNT];                             // eDMA driver state of the result channels
+static uint8_t mgl_adc_dma_stcd[ADC_INSTANCE_COUNT][STCD_SIZE(ADC_DMA_BUFFER_N)];               // memory for the 2 scatter/gather TCDs (32 byte aligned by STCD_ADDR)
+static uint32_t mgl_adc_dma_buffer[ADC_INSTANCE_COUNT][ADC_DMA_BUFFER_N][ADC_DMA_RESULT_N];     // copies of the result registers, indexed by control channel
+static volatile uint8_t mgl_adc_dma_ready[ADC_INSTANCE_COUNT];                                  // buffer which holds the last complete frame
+#endif
 
 // ===================================================================================================
 // Internal function prototypes
@@ -68,6 +216,30 @@ void pdb_init(void);
 
 uint32_t adc_get_counter(uint8_t adc_instance, IRQn_Type adc_interrupt);
 
+void adc_build_channel_index(void);
+
+void adc_cal_cache_load(void);
+static inline uint16_t adc_cal_apply(const struct_adc_cal_cache_t *ptr_cal, uint16_t digit);
+static void adc_cal_cache_load_chn(uint8_t i);
+static void adc_cal_cache_check(void);
+
+static void float_avg_update_window(floating_avg_data_t *float_avg_data);
+
+static void adc_pdb_set_timing(uint32_t pdb_instance, uint16_t modulus);
+static void adc_oversampling_frame(uint8_t adc_instance);
+
+static void adc_mux_init(void);
+static void adc_mux_select(uint8_t group);
+static uint8_t adc_mux_schedule(uint8_t current, bool refreshed);
+
+static void adc_copy_instance_results(uint8_t adc_instance);
+static void adc_frame_publish(uint8_t multiplex_group);
+
+#if ADC_DMA_RESULTS
+void adc_dma_init(uint8_t adc_instance, uint8_t dma_channel, dma_request_source_t request);
+void adc_dma_frame_done(void *parameter, edma_chn_status_t status);
+#endif
+
 // ===================================================================================================
 // Functions
 // ===================================================================================================
@@ -75,12 +247,21 @@ void pdb_init(void)
 {
 	// todo: this hasn't been tested on all hardware variants. can PDB channels be initialized even if they are unused?
 
+#if ADC_DMA_RESULTS
+    // the PDB interrupt flag requests the eDMA result channel instead of an interrupt
+    pdb_timer_config_t pdb_config = pdb_InitConfig0;
+    pdb_config.dmaEnable = true;
+    pdb_config.intEnable = false;
+#else
+    const pdb_timer_config_t pdb_config = pdb_InitConfig0;
+#endif
+
     // init PDB 0
-    PDB_DRV_Init(INST_PDB1, &pdb_InitConfig0);
+    PDB_DRV_Init(INST_PDB1, &pdb_config);
     PDB_DRV_Enable(INST_PDB1);
 
     // init PDB 1
-    PDB_DRV_Init(INST_PDB2, &pdb_InitConfig0);
+    PDB_DRV_Init(INST_PDB2, &pdb_config);
     PDB_DRV_Enable(INST_PDB2);
 
     // init all channels and pretriggers
@@ -90,33 +271,12 @@ void pdb_init(void)
     }
 
 
-	// configure delay value (later used to calculate individiual delay values for PDB channels)
-    uint32_t delayValue = 4000;
-
-    // ============================================
-    // PDB0
-        PDB_DRV_SetTimerModulusValue(INST_PDB1, (uint32_t)delayValue);
-        PDB_DRV_SetAdcPreTriggerDelayValue(INST_PDB1, 0UL, 0UL, ((uint32_t)delayValue/4)*0);
-        PDB_DRV_SetAdcPreTriggerDelayValue(INST_PDB1, 1UL, 0UL, ((uint32_t)delayValue/4)*1);
-	// ============================================
-	// PDB1
-        PDB_DRV_SetTimerModulusValue(INST_PDB2, (uint32_t)delayValue);
-        PDB_DRV_SetAdcPreTriggerDelayValue(INST_PDB2, 0UL, 0UL, ((uint32_t)delayValue/4)*0);
-        PDB_DRV_SetAdcPreTriggerDelayValue(INST_PDB2, 1UL, 0UL, ((uint32_t)delayValue/4)*1);
-
-#if (defined(S32K148))
-        PDB_DRV_SetAdcPreTriggerDelayValue(INST_PDB1, 2UL, 0UL, ((uint32_t)delayValue/4)*2 );
-        PDB_DRV_SetAdcPreTriggerDelayValue(INST_PDB1, 3UL, 0UL, ((uint32_t)delayValue/4)*3 );
-
-        PDB_DRV_SetAdcPreTriggerDelayValue(INST_PDB2, 2UL, 0UL, ((uint32_t)delayValue/4)*2);
-        PDB_DRV_SetAdcPreTriggerDelayValue(INST_PDB2, 3UL, 0UL, ((uint32_t)delayValue/4)*3 );
-
-#endif
-		PDB_DRV_LoadValuesCmd(INST_PDB1);
-		PDB_DRV_SoftTriggerCmd(INST_PDB1);
+    // PDB cycle and pre-trigger delays of the acquisition profile
+    adc_pdb_set_timing(INST_PDB1, mgl_adc_acq_profile_tbl[mgl_adc_acq_profile].pdb_modulus);
+    adc_pdb_set_timing(INST_PDB2, mgl_adc_acq_profile_tbl[mgl_adc_acq_profile].pdb_modulus);
 
-        PDB_DRV_LoadValuesCmd(INST_PDB2);
-        PDB_DRV_SoftTriggerCmd(INST_PDB2);
+    PDB_DRV_SoftTriggerCmd(INST_PDB1);
+    PDB_DRV_SoftTriggerCmd(INST_PDB2);
 
 }
 
@@ -171,6 +331,16 @@ void ADC_init(void)
 		ADC_DRV_AutoCalibration(INST_ADCONV2);
     }
 
+    // hardware averaging of the acquisition profile, the PDB cycle is set by pdb_init
+    {
+        adc_average_config_t avg_config;
+        ADC_DRV_InitHwAverageStruct(&avg_config);
+        avg_config.hwAvgEnable = mgl_adc_acq_profile_tbl[mgl_adc_acq_profile].hw_avg_enable;
+        avg_config.hwAverage = mgl_adc_acq_profile_tbl[mgl_adc_acq_profile].hw_avg;
+        ADC_DRV_ConfigHwAverage(INST_ADCONV1, &avg_config);
+        ADC_DRV_ConfigHwAverage(INST_ADCONV2, &avg_config);
+    }
+
 #if 0
     // ---------------------------------------------------------------------------------------------------
     // use custom userGain/userOffset for 5V vref correction from EEPROM. UNFINISHED and UNSUPPORTED.
@@ -201,18 +371,27 @@ void ADC_init(void)
         {
         ADC_DRV_ConfigChan(adc_config_tbl[i].adc_instance, adc_config_tbl[i].adc_channel, &adc_init_config_tbl[i].channel_cfg);
         }
-        else
-        {
-            if (adc_config_tbl[i].multiplex_group > mgl_multiplex_group_max)
-            {
-                mgl_multiplex_group_max++;
-            }
-        }
     }
 
+    // Channel lists for the interrupt, the result copy and the multiplexer
+    adc_build_channel_index();
+    adc_mux_init();
+
+    // Calibration tables into RAM, adc_processing doesn't access the EEPROM
+    adc_cal_cache_load();
+
+    // Default filter of all channels
+    adc_filter_init();
+
+#if ADC_DMA_RESULTS
+    // The eDMA channels have to be armed before the first PDB cycle
+    adc_dma_init(INST_ADCONV1, ADC_DMA_CHN_ADCONV1, EDMA_REQ_PDB0);
+    adc_dma_init(INST_ADCONV2, ADC_DMA_CHN_ADCONV2, EDMA_REQ_PDB1);
+#else
     // Install interrupt handler
     INT_SYS_InstallHandler(ADC0_IRQn, &ADC1_IRQHandler, (isr_t*) 0);
     INT_SYS_InstallHandler(ADC1_IRQn, &ADC2_IRQHandler, (isr_t*) 0);
+#endif
 
 #if NEW_PDB_CODE
     pdb_init();
@@ -221,231 +400,1274 @@ void ADC_init(void)
     pdb1_init();
 #endif
 
+#if !ADC_DMA_RESULTS
     /* Enable ADC interrupts */
     INT_SYS_EnableIRQ(ADC0_IRQn);
     INT_SYS_EnableIRQ(ADC1_IRQn);
+#endif
 }
 
-void ADC_IRQHandler(uint8_t pdb_instance, uint8_t adc_instance)
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Builds the channel lists from adc_config_tbl, so that the interrupt and the copy loops don't
+* have to search the whole table for the channels of one instance or multiplex group.
+* For every ADC instance the first entry of each control channel is read from the ADC, the
+* multiplexed entries sharing that control channel take its value (source_index).
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void adc_build_channel_index(void)
 {
-    // Cycle through all ADC channels
-    for (uint8_t channel = 0; channel < ADC_MAX; channel++)
+    bool listed[ADC_MAX] = {false};
+    uint8_t cnt = 0u;
+
+    for (uint8_t inst = 0; inst < ADC_INSTANCE_COUNT; inst++)
     {
-        // Only the pins of the ADC instance are relevant, which has triggered the interrupt
-        if (adc_config_tbl[channel].adc_instance == adc_instance)
+        mgl_adc_chan_first[inst] = cnt;
+
+        // one entry per control channel, these are read from the ADC
+        for (uint8_t i = 0; i < ADC_MAX; i++)
         {
-                // Get channel result and put it into adc_interrupt_values variable, clear interrupt
-                ADC_DRV_GetChanResult(adc_config_tbl[channel].adc_instance, adc_config_tbl[channel].adc_channel, &(adc_interrupt_values[channel]));
+            if (adc_config_tbl[i].adc_instance == inst)
+            {
+                bool found = false;
+                for (uint8_t k = mgl_adc_chan_first[inst]; (k < cnt) && (found == false); k++)
+                {
+                    found = (mgl_adc_chan_ref[k].adc_channel == adc_config_tbl[i].adc_channel);
+                }
+
+                if (found == false)
+                {
+                    mgl_adc_chan_ref[cnt].result_index = i;
+                    mgl_adc_chan_ref[cnt].adc_channel = adc_config_tbl[i].adc_channel;
+                    mgl_adc_chan_ref[cnt].source_index = i;
+                    listed[i] = true;
+                    cnt++;
+                }
+            }
         }
-    }
+        mgl_adc_chan_read_end[inst] = cnt;
 
-    PDB_DRV_SoftTriggerCmd(pdb_instance);
-    //increment the global adc interrupt counter.
-    mgl_adc_counter[adc_instance]++;
-}
+        // entries sharing a control channel with one of the above
+        for (uint8_t i = 0; i < ADC_MAX; i++)
+        {
+            if ((adc_config_tbl[i].adc_instance == inst) && (listed[i] == false))
+            {
+                for (uint8_t k = mgl_adc_chan_first[inst]; k < mgl_adc_chan_read_end[inst]; k++)
+                {
+                    if (mgl_adc_chan_ref[k].adc_channel == adc_config_tbl[i].adc_channel)
+                    {
+                        mgl_adc_chan_ref[cnt].source_index = mgl_adc_chan_ref[k].result_index;
+                    }
+                }
+                mgl_adc_chan_ref[cnt].result_index = i;
+                mgl_adc_chan_ref[cnt].adc_channel = adc_config_tbl[i].adc_channel;
+                cnt++;
+            }
+        }
+    }
+    mgl_adc_chan_first[ADC_INSTANCE_COUNT] = cnt;
 
-/* @brief: ADC Interrupt Service Routines */
-void ADC1_IRQHandler(void)
-{
-    ADC_IRQHandler(INST_PDB1, INST_ADCONV1);
-}
+    // multiplexer: channels which are always valid and channels per multiplex group
+    mgl_adc_direct_cnt = 0u;
+    mgl_multiplex_group_max = 0u;
+    cnt = 0u;
+    for (uint8_t group = 0; group < ADC_MUX_GROUP_N; group++)
+    {
+        mgl_adc_mux_first[group] = cnt;
+        for (uint8_t i = 0; i < ADC_MAX; i++)
+        {
+            if ((adc_config_tbl[i].multiplex) && (adc_config_tbl[i].multiplex_group == group))
+            {
+                mgl_adc_mux_idx[cnt] = i;
+                cnt++;
+                mgl_multiplex_group_max = group;
+            }
+        }
+    }
+    mgl_adc_mux_first[ADC_MUX_GROUP_N] = cnt;
 
-void ADC2_IRQHandler(void)
-{
-    ADC_IRQHandler(INST_PDB2, INST_ADCONV2);
+    for (uint8_t i = 0; i < ADC_MAX; i++)
+    {
+        if (adc_config_tbl[i].multiplex == 0)
+        {
+            mgl_adc_direct_idx[mgl_adc_direct_cnt] = i;
+            mgl_adc_direct_cnt++;
+        }
+    }
 }
 
-
 /*----------------------------------------------------------------------------*/
 /**
-*  Get the global adc interrupt counter.
-*
 * \internal
+* Reads the calibration table of one channel from the EEPROM and converts the support points into
+* straight line segments with a fixed-point slope. Replaces the ee_read and
+* os_util_lookup1D(..., LUT_MODE_EXTRAPOLATION_POS) of every sample in adc_processing, the result
+* differs from the lookup by at most 1 because the slope is rounded instead of dividing per sample.
+* The words of the table are kept in mgl_adc_cal_raw for adc_cal_cache_check. The segments are
+* prepared on the stack and copied with the interrupts locked, adc_get_cal_of_digit may run in the
+* frame interrupt.
 * \endinternal
 *
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
 */
-uint32_t adc_get_counter(uint8_t adc_instance, IRQn_Type adc_interrupt)
+static void adc_cal_cache_load_chn(uint8_t i)
 {
-    uint32_t counter;
+    struct_adc_cal_cache_t cal = { .state = ADC_CAL_STATE_EMPTY };
+    const int16_t *ptr = NULL;
 
-    INT_SYS_DisableIRQ(adc_interrupt); //while getting the value of the counter, the adc interrupts are disabled.
-    counter = mgl_adc_counter[adc_instance];
-    INT_SYS_EnableIRQ(adc_interrupt);
+    if (adc_config_tbl[i].cal_type != CALIB_NONE)
+    {
+        ptr = (const int16_t*) ee_read(CALIBR_EE_TABLE_DATA_ADDR + adc_config_tbl[i].cal_index);
+    }
 
-    return counter;
-}
+    if (NULL != ptr)
+    {
+        for (uint8_t k = 0; k < ADC_CAL_RAW_N; k++)
+        {
+            mgl_adc_cal_raw[i][k] = ptr[k];
+        }
+    }
 
-// ===================================================================================================
-// Public functions
-// ===================================================================================================
-uint32_t adc_get_measurement_range(enum_adc_pin_name const pin)
-{
-	uint32_t range = adc_config_tbl[pin].adc_vrefh;
-#if ADC_SECOND_RANGE
-	range = modulhardwarecode_adc_get_vrefh2(pin, range);
-#endif
+    //calibrated values saved on this eeprom area
+    if ( (NULL != ptr) && (-1 != *ptr) )
+    {
+        switch ( adc_config_tbl[i].cal_type )
+        {
+            case CALIB_SOURCE_3P:       //three source points: x[0..2] followed by y[0..2]
+            case CALIB_SOURCE_SINK_3P:  //the sink points behind the source points are ignored, see todo in the measurement adaption
+            {
+                const int16_t *tab_x = ptr;
+                const int16_t *tab_y = ptr + CALIB_POINTS_SOURCE;
 
-	return range;
-}
+                for (uint8_t k = 0; k < ADC_CAL_SEGMENT_N; k++)
+                {
+                    int32_t dx = (int32_t)tab_x[k + 1u] - tab_x[k];
+                    int64_t slope = 0;
+
+                    // same line as the lookup: interpolation inside, extrapolation below the first and above the last point
+                    if (dx != 0)
+                    {
+                        slope = ((int64_t)((int32_t)tab_y[k + 1u] - tab_y[k]) << ADC_CAL_SLOPE_SHIFT) / dx;
+                    }
+                    if (slope > INT32_MAX)
+                    {
+                        slope = INT32_MAX;
+                    }
+                    else if (slope < INT32_MIN)
+                    {
+                        slope = INT32_MIN;
+                    }
+
+                    cal.seg[k].x = tab_x[k];
+                    cal.seg[k].y = tab_y[k];
+                    cal.seg[k].slope = (int32_t)slope;
+                    cal.x_upper[k] = tab_x[k + 1u];
+                }
+                cal.state = ADC_CAL_STATE_VALID;
+                break;
+            }
 
+            default:
+                cal.state = ADC_CAL_STATE_UNSUPPORTED;
+                break;
+        }
+    }
+
+    INT_SYS_DisableIRQGlobal();
+    mgl_adc_cal[i] = cal;
+    INT_SYS_EnableIRQGlobal();
+}
 
 /*----------------------------------------------------------------------------*/
 /**
-*  Returns the two-byte module identifier which is sitting at address 0
-*  of calibration table
+* \internal
+* Called in ADC_init.
+* \endinternal
 *
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
 */
-uint16_t adc_get_module_type()
+void adc_cal_cache_load(void)
 {
-    // The first record (uint16_t) keeps the module identifier
-    uint16_t *ptr = (uint16_t*)ee_read(CALIBR_EE_TABLE_MODULE_ADDR);
-    uint16_t tmp = (NULL != ptr) ? (*ptr) : 0u;
-    return tmp;
+    for (uint8_t i = 0; i < ADC_MAX; i++)
+    {
+        adc_cal_cache_load_chn(i);
+    }
 }
 
 /*----------------------------------------------------------------------------*/
 /**
 * \internal
-* This function is used to copy the ADC results from the ADC interrupt to a structure element which can be used for further processing
-* without disabling the ADC interrupts again.
-*
+* The calibration table is written by the bootloader protocol (role_protocol_bl in the prebuilt
+* lib_bl_protocol), which has no notification. Per call the EEPROM tables of ADC_CAL_CHECK_PER_CALL
+* calibrated channels are compared with the words of the last load, a channel whose table has
+* changed is loaded again. All channels are checked within ADC_MAX / ADC_CAL_CHECK_PER_CALL calls.
 * \endinternal
 *
 * Date       | Type    | Person
 * -----------|---------|-----------
-* 20210218   | Author  | jallgeier
+* 20261019   | Author  | agent
 */
-void adc_copy_results_from_interrupt(uint8_t adc_instance, uint8_t* adc_done_flag, uint32_t* adc_counter, IRQn_Type adc_interrupt )
+static void adc_cal_cache_check(void)
 {
-    uint32_t tmp_counter;
-
-    tmp_counter = adc_get_counter(adc_instance, adc_interrupt);//get the global adc interrupt counter.
+    static uint8_t next = 0u;
 
-
-    //check if there are new ADC values available
-    if (tmp_counter != *adc_counter)
+    for (uint8_t n = 0; n < ADC_CAL_CHECK_PER_CALL; n++)
     {
-        //Set a flag to indicate that new adc values are available
-        *adc_done_flag = 1;
+        const uint8_t i = next;
 
-        INT_SYS_DisableIRQ(adc_interrupt);
-        //simply copy of the measured ADC register values.
-        for ( uint8_t i = 0; i < ADC_MAX; ++i )
+        next = ((next + 1u) < ADC_MAX) ? (next + 1u) : 0u;
+
+        if (adc_config_tbl[i].cal_type != CALIB_NONE)
         {
-            if(adc_config_tbl[i].adc_instance == adc_instance)
+            const int16_t *ptr = (const int16_t*) ee_read(CALIBR_EE_TABLE_DATA_ADDR + adc_config_tbl[i].cal_index);
+
+            if (NULL != ptr)
             {
-                adc_results[i].result_raw = adc_interrupt_values[i];
+                for (uint8_t k = 0; k < ADC_CAL_RAW_N; k++)
+                {
+                    if (ptr[k] != mgl_adc_cal_raw[i][k])
+                    {
+                        adc_cal_cache_load_chn(i);
+                        break;
+                    }
+                }
             }
-
         }
-        INT_SYS_EnableIRQ(adc_interrupt);
-        *adc_counter = tmp_counter; // set the local adc_counter to the same value as the temporary adc counter
     }
 }
 
-
 /*----------------------------------------------------------------------------*/
 /**
-*  needs to be called periodically, ideally after each ADC cycle is completed to ensure calibrated values and raw adc samples are in sync
-*
 * \internal
+* Calibrated value of one sample: segment search over the support points, multiply, shift and add.
+* Limited to 0..NR_MAX_INT16 like LUT_MODE_EXTRAPOLATION_POS.
 * \endinternal
 *
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
 */
-void adc_processing(uint8_t *multiplex_group, bool hw_calibration_support)
+static inline uint16_t adc_cal_apply(const struct_adc_cal_cache_t *ptr_cal, uint16_t digit)
 {
-    static uint32_t adc1_counter = 0, adc2_counter = 0;//local counter which contains the value of the global adc interrupt counter
-    uint8_t adc_inst1_done = 0, adc_inst2_done = 0;//flag which indicates that new ADC values are available.
-    static uint32_t multiplex_adc1_counter = 0, multiplex_adc2_counter = 0; //multiplex counter which are used for stability purpose
-    bool right_multiplex_group = FALSE, adc1_stability_cnt_passed = FALSE, adc2_stability_cnt_passed = FALSE; //bool variables to make IF queries clearer
-    uint8_t number_points = 0;
+    const int32_t x = (int16_t)digit;
+    uint8_t k = 0u;
+    int32_t ret;
 
-    adc_copy_results_from_interrupt(INST_ADCONV1, &adc_inst1_done, &adc1_counter, ADC0_IRQn);
-    adc_copy_results_from_interrupt(INST_ADCONV2, &adc_inst2_done, &adc2_counter, ADC1_IRQn);
+    while ((k < (ADC_CAL_SEGMENT_N - 1u)) && (x > ptr_cal->x_upper[k]))
+    {
+        k++;
+    }
 
-    //Depending on the size of the capacitors at the analog input, a small residual from
-    //the previous selected input may be measured during multiplex switching. To give the
-    //capacitor enough time to discharge, some ADC measurements to the corresponding channel
-    //are "discarded" and only every MULTIPLEX_STABILITY_CYCLES measurement is stored.
-    adc1_stability_cnt_passed = (((adc1_counter) - (multiplex_adc1_counter)) >= MULTIPLEX_STABILITY_CYCLES);
-    adc2_stability_cnt_passed = (((adc2_counter) - (multiplex_adc2_counter)) >= MULTIPLEX_STABILITY_CYCLES);
+    ret = ptr_cal->seg[k].y + (int32_t)((((int64_t)ptr_cal->seg[k].slope * (x - ptr_cal->seg[k].x)) + (1 << (ADC_CAL_SLOPE_SHIFT - 1u))) >> ADC_CAL_SLOPE_SHIFT);
 
-    if (adc_inst1_done == 1 || adc_inst2_done == 1)
+    if (ret > NR_MAX_INT16)
     {
-        // ---------------------------------------------------------------------------------------------------
-        // Copying of the raw ADC values into the DIGITS results vector with distinction which multiplex group is currently selected.
-        // ---------------------------------------------------------------------------------------------------
-        for ( uint8_t i = 0; i < ADC_MAX; ++i )
-        {
-            //check if the currently selected multiplex_group is the same as the multiplex group from the ADC input which should be determinate in the loop.
-            right_multiplex_group = *multiplex_group == adc_config_tbl[i].multiplex_group;
+        ret = NR_MAX_INT16;
+    }
+    else if (ret < 0)
+    {
+        ret = 0;
+    }
 
-            if ( adc_config_tbl[i].multiplex )
-            {
-                //WARNING if the multiplex should ever wanted to be decouple, this code wouldn't work anymore.
-                if ( (right_multiplex_group) && (adc1_stability_cnt_passed && adc2_stability_cnt_passed) )
-                {
-                    adc_results[i].result_digit = adc_results[i].result_raw;
-                }
-            }
-            else
-            {
-                adc_results[i].result_digit = adc_results[i].result_raw;
-            }
+    return (uint16_t)ret;
+}
 
-            // ---------------------------------------------------------------------------------------------------
-            // Die Zuweisung der Gewichteten Werte ist aktuell noch auskommentiert. Grund ist die Laufzeit von ca.
-            // 85 us(+47% Gesamtlaufzeit) bei 38 ADC Channels bei der CC16. Aktuell befindet sich diese Zuweisung+Berechnung
-            // in der get_mV Funktion. Ziel der Berechnung an dieser Stelle ist, zum einen eine bessere Uebersicht
-            // zum Anderen, sollten im Falle vorhandener Kalibrierwerte, diese im Nachhinein in die result_unit
-            // geschrieben werden.
-            // ---------------------------------------------------------------------------------------------------
-            //adc_results[i].result_unit = ((adc_results[i].result_digit * adc_get_measurement_range(i)) / adc_config_tbl[i].resolution);
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Sets the PDB cycle and the pre-trigger delays of the PDB channels. Each channel starts its chain
+* of conversions a quarter of the cycle after the previous one, so the chains have room for the
+* longer conversions with hardware averaging as long as the modulus is scaled with it.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void adc_pdb_set_timing(uint32_t pdb_instance, uint16_t modulus)
+{
+    PDB_DRV_SetTimerModulusValue(pdb_instance, (uint32_t)modulus);
+    for (uint32_t chn = 0; chn < ADC_PDB_CHN_N; chn++)
+    {
+        PDB_DRV_SetAdcPreTriggerDelayValue(pdb_instance, chn, 0UL, ((uint32_t)modulus / ADC_PDB_DELAY_DIV) * chn);
+    }
+#if ADC_DMA_RESULTS
+    // collect the results at the end of the PDB cycle. The pre-trigger chain started at 3/4 of the
+    // cycle has to be finished at this point, as it is with the delays above.
+    PDB_DRV_SetValueForTimerInterrupt(pdb_instance, (uint32_t)modulus);
+#endif
+    PDB_DRV_LoadValuesCmd(pdb_instance);
+}
 
-            // ---------------------------------------------------------------------------------------------------
-            // Calibration part. Not every module has calibrated values, so in this case some code parts must not be executed. (to reduce runtime overhead)
-            // ---------------------------------------------------------------------------------------------------
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Adds the results of a completed frame to the oversampling windows of the instance. Called in the
+* frame interrupt (ADC_IRQHandler or adc_dma_frame_done) after the results have been stored.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void adc_oversampling_frame(uint8_t adc_instance)
+{
+#if ADC_DMA_RESULTS
+    const uint32_t *ptr_frame = mgl_adc_dma_buffer[adc_instance][mgl_adc_dma_ready[adc_instance]];
+#endif
+
+    for (uint8_t k = mgl_adc_os_first[adc_instance]; k < mgl_adc_os_first[adc_instance + 1u]; k++)
+    {
+        const struct_adc_chan_ref_t *ptr_ref = &mgl_adc_chan_ref[mgl_adc_os_ref[k]];
+        struct_adc_oversampling_t *ptr_os = &mgl_adc_os[ptr_ref->result_index];
+
+#if ADC_DMA_RESULTS
+        ptr_os->sum += (uint16_t)ptr_frame[ptr_ref->adc_channel];
+#else
+        ptr_os->sum += adc_interrupt_values[ptr_ref->source_index];
+#endif
+        ptr_os->cnt++;
+        // 4^bits results give bits additional bits
+        if (ptr_os->cnt >= (1u << (2u * ptr_os->bits)))
+        {
+            ptr_os->result = (uint16_t)(ptr_os->sum >> ptr_os->bits);
+            ptr_os->sum = 0u;
+            ptr_os->cnt = 0u;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Copies the values of the last frame of an ADC instance to result_raw and result_hires. The caller
+* checks that mgl_adc_counter hasn't changed meanwhile.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void adc_copy_instance_results(uint8_t adc_instance)
+{
+#if ADC_DMA_RESULTS
+    // the eDMA writes the other buffer, mgl_adc_dma_ready changes together with mgl_adc_counter
+    const uint32_t *ptr_frame = mgl_adc_dma_buffer[adc_instance][mgl_adc_dma_ready[adc_instance]];
+#endif
+
+    //simply copy of the measured ADC register values.
+    for ( uint8_t k = mgl_adc_chan_first[adc_instance]; k < mgl_adc_chan_first[adc_instance + 1u]; ++k )
+    {
+#if ADC_DMA_RESULTS
+        adc_results[mgl_adc_chan_ref[k].result_index].result_raw = (uint16_t)ptr_frame[mgl_adc_chan_ref[k].adc_channel];
+#else
+        adc_results[mgl_adc_chan_ref[k].result_index].result_raw = adc_interrupt_values[mgl_adc_chan_ref[k].source_index];
+#endif
+        adc_results[mgl_adc_chan_ref[k].result_index].result_hires = adc_results[mgl_adc_chan_ref[k].result_index].result_raw;
+    }
+    for ( uint8_t k = mgl_adc_os_first[adc_instance]; k < mgl_adc_os_first[adc_instance + 1u]; ++k )
+    {
+        const uint8_t idx = mgl_adc_chan_ref[mgl_adc_os_ref[k]].result_index;
+        adc_results[idx].result_hires = mgl_adc_os[idx].result;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Copies adc_results to the frame buffer which isn't the last published one and publishes it with the
+* next sequence number. The sequence number of the buffer is 0 while it is written, so a reader which
+* still copies the older frame from it sees the change (seqlock with 2 buffers). Readers of the last
+* frame are only disturbed if they are interrupted for longer than one adc_processing cycle.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void adc_frame_publish(uint8_t multiplex_group)
+{
+    uint32_t seq = mgl_adc_frame_seq + 1u;
+    struct_adc_frame_t *ptr_frame;
+    uint32_t now = 0u;
+
+    if (seq == 0u)
+    {
+        seq = 1u;   // 0 is reserved for "no frame"
+    }
+    ptr_frame = &mgl_adc_frame[seq % ADC_FRAME_BUFFER_N];
+
+    (void)hal_get_timestamp(&now, HAL_PRECISION_1MS);
+
+    ptr_frame->seq = 0u;
+    ADC_FRAME_BARRIER();
+    ptr_frame->timestamp_ms = now;
+    ptr_frame->multiplex_group = multiplex_group;
+    for ( uint8_t i = 0; i < ADC_MAX; ++i )
+    {
+        ptr_frame->results[i] = adc_results[i];
+    }
+    ADC_FRAME_BARRIER();
+    ptr_frame->seq = seq;
+    mgl_adc_frame_seq = seq;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Prepares the multiplexer: all select lines on one GPIO port are set with a single write, otherwise
+* modulhardwarecode_adc_multiplex is used. All groups start with the default schedule (priority 0,
+* period 0), which is the round-robin of the previous implementation.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void adc_mux_init(void)
+{
+    const enum_pin_name mux_pin[3] = {ADC_MUX_PIN_A, ADC_MUX_PIN_B, ADC_MUX_PIN_C};
+    GPIO_Type *gpio = g_pin_mux_InitConfigArr[mux_pin[0]].gpioBase;
+    uint32_t now = 0u;
+
+    mgl_adc_mux_mask = 0u;
+    for (uint8_t k = 0; k < 3u; k++)
+    {
+        if ( (g_pin_mux_InitConfigArr[mux_pin[k]].gpioBase != gpio) || (g_pin_mux_InitConfigArr[mux_pin[k]].mux != PORT_MUX_AS_GPIO) )
+        {
+            gpio = NULL;
+        }
+        mgl_adc_mux_mask |= (1UL << g_pin_mux_InitConfigArr[mux_pin[k]].pinPortIdx);
+    }
+    mgl_adc_mux_gpio = gpio;
+
+    for (uint8_t group = 0; group < ADC_MUX_GROUP_N; group++)
+    {
+        mgl_adc_mux_pattern[group] = 0u;
+        for (uint8_t k = 0; k < 3u; k++)
+        {
+            if (group & (1u << k))
+            {
+                mgl_adc_mux_pattern[group] |= (1UL << g_pin_mux_InitConfigArr[mux_pin[k]].pinPortIdx);
+            }
+        }
+    }
+
+    (void)hal_get_timestamp(&now, HAL_PRECISION_1MS);
+    for (uint8_t group = 0; group < ADC_MUX_GROUP_N; group++)
+    {
+        mgl_adc_mux_grp[group].priority = 0u;
+        mgl_adc_mux_grp[group].period_ms = 0u;
+        mgl_adc_mux_grp[group].idle_timeout_ms = 0u;
+        mgl_adc_mux_grp[group].last_refresh_ms = now;
+        mgl_adc_mux_grp[group].last_refresh_seq = 0u;
+        mgl_adc_mux_grp[group].last_read_ms = now;
+        mgl_adc_mux_grp[group].refresh_cnt = 0u;
+        mgl_adc_mux_grp[group].refresh_rate_mhz = 0u;
+    }
+    mgl_adc_mux_rate_start_ms = now;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Sets the select lines of a group. On one port the lines which differ are toggled with a single
+* write to PTOR, other pins of the port are not touched.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void adc_mux_select(uint8_t group)
+{
+    if ( (mgl_adc_mux_gpio != NULL) && (group < ADC_MUX_GROUP_N) )
+    {
+        mgl_adc_mux_gpio->PTOR = (mgl_adc_mux_gpio->PDOR ^ mgl_adc_mux_pattern[group]) & mgl_adc_mux_mask;
+    }
+    else
+    {
+        modulhardwarecode_adc_multiplex(group);
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Called when the current group has settled (MULTIPLEX_STABILITY_CYCLES). Counts the refresh of the
+* current group and returns the group to select next:
+* - a group is due if its refresh period has passed. A group which hasn't been read within its
+*   idle timeout is only due every ADC_MUX_IDLE_PERIOD_MS.
+* - of the due groups the one with the highest priority wins, then the one refreshed longest ago.
+* - the current group stays selected if no group is due.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static uint8_t adc_mux_schedule(uint8_t current, bool refreshed)
+{
+    uint32_t now = 0u;
+    uint8_t next = current;
+    bool found = false;
+
+    (void)hal_get_timestamp(&now, HAL_PRECISION_1MS);
+
+    if ( (refreshed) && (current < ADC_MUX_GROUP_N) )
+    {
+        mgl_adc_mux_refresh_seq++;
+        mgl_adc_mux_grp[current].last_refresh_ms = now;
+        mgl_adc_mux_grp[current].last_refresh_seq = mgl_adc_mux_refresh_seq;
+        mgl_adc_mux_grp[current].refresh_cnt++;
+    }
+
+    // publish the achieved refresh rates
+    if ( (now - mgl_adc_mux_rate_start_ms) >= ADC_MUX_RATE_WINDOW_MS )
+    {
+        for (uint8_t group = 0; group < ADC_MUX_GROUP_N; group++)
+        {
+            mgl_adc_mux_grp[group].refresh_rate_mhz = (uint32_t)(((uint64_t)mgl_adc_mux_grp[group].refresh_cnt * 1000000u) / (now - mgl_adc_mux_rate_start_ms));
+            mgl_adc_mux_grp[group].refresh_cnt = 0u;
+        }
+        mgl_adc_mux_rate_start_ms = now;
+    }
+
+    for (uint8_t group = 0; group <= mgl_multiplex_group_max; group++)
+    {
+        struct_adc_mux_group_t *ptr_grp = &mgl_adc_mux_grp[group];
+        uint32_t period = ptr_grp->period_ms;
+
+        if (mgl_adc_mux_read[group])
+        {
+            mgl_adc_mux_read[group] = FALSE;
+            ptr_grp->last_read_ms = now;
+        }
+
+        // groups without channels are never selected
+        if (mgl_adc_mux_first[group] == mgl_adc_mux_first[group + 1u])
+        {
+            continue;
+        }
+
+        // nobody has read the group recently
+        if ( (ptr_grp->idle_timeout_ms > 0u) && ((now - ptr_grp->last_read_ms) > ptr_grp->idle_timeout_ms) && (period < ADC_MUX_IDLE_PERIOD_MS) )
+        {
+            period = ADC_MUX_IDLE_PERIOD_MS;
+        }
+
+        if ( (now - ptr_grp->last_refresh_ms) >= period )
+        {
+            if ( (found == false) ||
+                 (ptr_grp->priority > mgl_adc_mux_grp[next].priority) ||
+                 ((ptr_grp->priority == mgl_adc_mux_grp[next].priority) && ((int32_t)(ptr_grp->last_refresh_seq - mgl_adc_mux_grp[next].last_refresh_seq) < 0)) )
+            {
+                next = group;
+                found = true;
+            }
+        }
+    }
+
+    return next;
+}
+
+#if ADC_DMA_RESULTS
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Sets up the eDMA channel which copies the result registers of one ADC instance into
+* mgl_adc_dma_buffer. Each PDB cycle end requests one minor loop that copies the registers
+* of control channel 0 up to the highest one used in adc_config_tbl. Two TCDs linked by
+* scatter/gather alternate between the two buffers, so the eDMA never writes into the frame
+* that has been reported by adc_dma_frame_done last.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void adc_dma_init(uint8_t adc_instance, uint8_t dma_channel, dma_request_source_t request)
+{
+    ADC_Type * const adc_base[ADC_INSTANCE_COUNT] = ADC_BASE_PTRS;
+    edma_software_tcd_t *stcd = (edma_software_tcd_t*)STCD_ADDR(mgl_adc_dma_stcd[adc_instance]);
+    edma_loop_transfer_config_t loop_config = {0};
+    edma_transfer_config_t transfer_config = {0};
+    edma_channel_config_t channel_config = {0};
+    uint32_t result_cnt = 0u;
+
+    // highest control channel of this instance
+    for (uint8_t k = mgl_adc_chan_first[adc_instance]; k < mgl_adc_chan_read_end[adc_instance]; k++)
+    {
+        if (mgl_adc_chan_ref[k].adc_channel >= result_cnt)
+        {
+            result_cnt = mgl_adc_chan_ref[k].adc_channel + 1u;
+        }
+    }
+
+    channel_config.channelPriority = EDMA_CHN_DEFAULT_PRIORITY;
+    channel_config.virtChnConfig = dma_channel;
+    channel_config.source = request;
+    channel_config.callback = &adc_dma_frame_done;
+    channel_config.callbackParam = (void*)(uint32_t)adc_instance;
+    channel_config.enableTrigger = false;
+    (void)EDMA_DRV_ChannelInit(&mgl_adc_dma_chn_state[adc_instance], &channel_config);
+
+    // one request = one frame: result_cnt 32 bit registers, then back to the first register
+    loop_config.majorLoopIterationCount = 1u;
+    transfer_config.srcAddr = (uint32_t)ADC_DMA_RESULT_REG(adc_base[adc_instance]);
+    transfer_config.srcTransferSize = EDMA_TRANSFER_SIZE_4B;
+    transfer_config.destTransferSize = EDMA_TRANSFER_SIZE_4B;
+    transfer_config.srcOffset = 4;
+    transfer_config.destOffset = 4;
+    transfer_config.srcLastAddrAdjust = -(int32_t)(result_cnt * 4u);
+    transfer_config.srcModulo = EDMA_MODULO_OFF;
+    transfer_config.destModulo = EDMA_MODULO_OFF;
+    transfer_config.minorByteTransferCount = result_cnt * 4u;
+    transfer_config.scatterGatherEnable = true;
+    transfer_config.interruptEnable = true;
+    transfer_config.loopTransferConfig = &loop_config;
+
+    for (uint8_t k = 0; k < ADC_DMA_BUFFER_N; k++)
+    {
+        transfer_config.destAddr = (uint32_t)mgl_adc_dma_buffer[adc_instance][k];
+        transfer_config.scatterGatherNextDescAddr = (uint32_t)&stcd[(k + 1u) % ADC_DMA_BUFFER_N];
+        EDMA_DRV_PushConfigToSTCD(&transfer_config, &stcd[k]);
+    }
+
+    // the first frame goes into buffer 0, adc_dma_frame_done toggles to it
+    mgl_adc_dma_ready[adc_instance] = ADC_DMA_BUFFER_N - 1u;
+    transfer_config.destAddr = (uint32_t)mgl_adc_dma_buffer[adc_instance][0];
+    transfer_config.scatterGatherNextDescAddr = (uint32_t)&stcd[1];
+    EDMA_DRV_PushConfigToReg(dma_channel, &transfer_config);
+    (void)EDMA_DRV_StartChannel(dma_channel);
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* eDMA major loop callback of the result channels, called once per PDB cycle instead of
+* ADC_IRQHandler. Publishes the completed buffer and starts the next PDB cycle.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void adc_dma_frame_done(void *parameter, edma_chn_status_t status)
+{
+    const uint8_t adc_instance = (uint8_t)(uint32_t)parameter;
+
+    if (status == EDMA_CHN_NORMAL)
+    {
+        mgl_adc_dma_ready[adc_instance] = (mgl_adc_dma_ready[adc_instance] + 1u) % ADC_DMA_BUFFER_N;
+        adc_oversampling_frame(adc_instance);
+        adc_capture_frame(adc_instance, mgl_adc_dma_buffer[adc_instance][mgl_adc_dma_ready[adc_instance]]);
+        current_ctrl_frame(adc_instance, mgl_adc_dma_buffer[adc_instance][mgl_adc_dma_ready[adc_instance]]);
+        sched_app_event_post(SCHED_EVT_ADC_FRAME);
+        //increment the global adc interrupt counter.
+        mgl_adc_counter[adc_instance]++;
+    }
+
+    PDB_DRV_SoftTriggerCmd((adc_instance == INST_ADCONV1) ? INST_PDB1 : INST_PDB2);
+}
+#endif
+
+void ADC_IRQHandler(uint8_t pdb_instance, uint8_t adc_instance)
+{
+    PROF_APP_BEGIN(PROF_SEC_ISR_ADC);
+
+    // Cycle through the control channels of the ADC instance, which has triggered the interrupt
+    for (uint8_t k = mgl_adc_chan_first[adc_instance]; k < mgl_adc_chan_read_end[adc_instance]; k++)
+    {
+        // Get channel result and put it into adc_interrupt_values variable, clear interrupt
+        ADC_DRV_GetChanResult(adc_instance, mgl_adc_chan_ref[k].adc_channel, &(adc_interrupt_values[mgl_adc_chan_ref[k].result_index]));
+    }
+
+    adc_oversampling_frame(adc_instance);
+#if (ADC_DMA_RESULTS == 0)
+    adc_capture_frame(adc_instance, adc_interrupt_values);
+    current_ctrl_frame(adc_instance, adc_interrupt_values);
+    sched_app_event_post(SCHED_EVT_ADC_FRAME);
+#endif
+
+    PDB_DRV_SoftTriggerCmd(pdb_instance);
+    //increment the global adc interrupt counter.
+    mgl_adc_counter[adc_instance]++;
+
+    PROF_APP_END(PROF_SEC_ISR_ADC);
+}
+
+/* @brief: ADC Interrupt Service Routines */
+void ADC1_IRQHandler(void)
+{
+    ADC_IRQHandler(INST_PDB1, INST_ADCONV1);
+}
+
+void ADC2_IRQHandler(void)
+{
+    ADC_IRQHandler(INST_PDB2, INST_ADCONV2);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+*  Get the global adc interrupt counter.
+*
+* \internal
+* \endinternal
+*
+*/
+uint32_t adc_get_counter(uint8_t adc_instance, IRQn_Type adc_interrupt)
+{
+    uint32_t counter;
+
+    INT_SYS_DisableIRQ(adc_interrupt); //while getting the value of the counter, the adc interrupts are disabled.
+    counter = mgl_adc_counter[adc_instance];
+    INT_SYS_EnableIRQ(adc_interrupt);
+
+    return counter;
+}
+
+// ===================================================================================================
+// Public functions
+// ===================================================================================================
+uint32_t adc_get_measurement_range(enum_adc_pin_name const pin)
+{
+	uint32_t range = adc_config_tbl[pin].adc_vrefh;
+#if ADC_SECOND_RANGE
+	range = modulhardwarecode_adc_get_vrefh2(pin, range);
+#endif
+
+	return range;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+bool adc_set_acquisition_profile(uint8_t profile)
+{
+    bool ret = false;
+
+    if (profile < ADC_ACQ_PROFILE_MAX)
+    {
+        adc_average_config_t avg_config;
+        const struct_adc_acq_profile_t *ptr_profile = &mgl_adc_acq_profile_tbl[profile];
+
+        ADC_DRV_InitHwAverageStruct(&avg_config);
+        avg_config.hwAvgEnable = ptr_profile->hw_avg_enable;
+        avg_config.hwAverage = ptr_profile->hw_avg;
+
+        INT_SYS_DisableIRQ(ADC_RESULT_IRQN_ADCONV1);
+        INT_SYS_DisableIRQ(ADC_RESULT_IRQN_ADCONV2);
+        ADC_DRV_ConfigHwAverage(INST_ADCONV1, &avg_config);
+        ADC_DRV_ConfigHwAverage(INST_ADCONV2, &avg_config);
+        adc_pdb_set_timing(INST_PDB1, ptr_profile->pdb_modulus);
+        adc_pdb_set_timing(INST_PDB2, ptr_profile->pdb_modulus);
+        mgl_adc_acq_profile = profile;
+        INT_SYS_EnableIRQ(ADC_RESULT_IRQN_ADCONV1);
+        INT_SYS_EnableIRQ(ADC_RESULT_IRQN_ADCONV2);
+        ret = true;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t adc_get_acquisition_profile(void)
+{
+    return mgl_adc_acq_profile;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The list of oversampled channels is built again with the frame interrupts of both instances
+* disabled. A changed channel starts with an empty window.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+bool adc_set_oversampling(enum_adc_pin_name pin, uint8_t extra_bits)
+{
+    bool ret = false;
+    uint8_t cnt = 0u;
+
+    if ( (pin < ADC_MAX) && (adc_config_tbl[pin].multiplex == 0) && (extra_bits <= ADC_OVERSAMPLING_BITS_MAX) )
+    {
+        INT_SYS_DisableIRQ(ADC_RESULT_IRQN_ADCONV1);
+        INT_SYS_DisableIRQ(ADC_RESULT_IRQN_ADCONV2);
+
+        mgl_adc_os[pin].bits = extra_bits;
+        mgl_adc_os[pin].sum = 0u;
+        mgl_adc_os[pin].cnt = 0u;
+        mgl_adc_os[pin].result = (uint16_t)(adc_results[pin].result_raw << extra_bits);
+
+        for (uint8_t inst = 0; inst < ADC_INSTANCE_COUNT; inst++)
+        {
+            mgl_adc_os_first[inst] = cnt;
+            for (uint8_t k = mgl_adc_chan_first[inst]; k < mgl_adc_chan_first[inst + 1u]; k++)
+            {
+                if (mgl_adc_os[mgl_adc_chan_ref[k].result_index].bits > 0u)
+                {
+                    mgl_adc_os_ref[cnt] = k;
+                    cnt++;
+                }
+            }
+        }
+        mgl_adc_os_first[ADC_INSTANCE_COUNT] = cnt;
+
+        INT_SYS_EnableIRQ(ADC_RESULT_IRQN_ADCONV1);
+        INT_SYS_EnableIRQ(ADC_RESULT_IRQN_ADCONV2);
+        ret = true;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The PDB is clocked by the bus clock, divided by the prescaler and the multiplication factor of
+* pdb_InitConfig0.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint32_t adc_get_sample_rate_mhz(enum_adc_pin_name pin)
+{
+    static const uint8_t pdb_mult[] = {1u, 10u, 20u, 40u};     // pdb_clk_prescaler_mult_factor_t
+    uint32_t bus_clock = 0u;
+    uint64_t divider;
+    uint32_t rate = 0u;
+
+    if ( (pin < ADC_MAX) && (STATUS_SUCCESS == CLOCK_SYS_GetFreq(BUS_CLOCK, &bus_clock)) )
+    {
+        divider = ((uint64_t)1u << (uint32_t)pdb_InitConfig0.clkPreDiv) * pdb_mult[(uint32_t)pdb_InitConfig0.clkPreMultFactor & 3u]
+                * mgl_adc_acq_profile_tbl[mgl_adc_acq_profile].pdb_modulus;
+
+        divider <<= (2u * mgl_adc_os[pin].bits);
+        rate = (uint32_t)(((uint64_t)bus_clock * 1000u) / divider);
+
+        // multiplexed channels: achieved refresh rate of the group
+        if (adc_config_tbl[pin].multiplex)
+        {
+            rate = adc_mux_get_refresh_rate_mhz(adc_config_tbl[pin].multiplex_group);
+        }
+    }
+
+    return rate;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+bool adc_mux_set_group(uint8_t group, uint8_t priority, uint16_t period_ms, uint16_t idle_timeout_ms)
+{
+    bool ret = false;
+
+    if (group < ADC_MUX_GROUP_N)
+    {
+        mgl_adc_mux_grp[group].priority = priority;
+        mgl_adc_mux_grp[group].period_ms = period_ms;
+        mgl_adc_mux_grp[group].idle_timeout_ms = idle_timeout_ms;
+        ret = true;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint32_t adc_mux_get_refresh_rate_mhz(uint8_t group)
+{
+    return (group < ADC_MUX_GROUP_N) ? mgl_adc_mux_grp[group].refresh_rate_mhz : 0u;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Only sets a flag, the time is taken by the scheduler. Can be called from interrupts.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void adc_mux_touch(enum_adc_pin_name pin)
+{
+    if ( (pin < ADC_MAX) && (adc_config_tbl[pin].multiplex) && (adc_config_tbl[pin].multiplex_group < ADC_MUX_GROUP_N) )
+    {
+        mgl_adc_mux_read[adc_config_tbl[pin].multiplex_group] = TRUE;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint32_t adc_frame_get_seq(void)
+{
+    return mgl_adc_frame_seq;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+bool adc_get_frame_index(enum_adc_pin_name pin, uint8_t *ptr_instance, uint8_t *ptr_index)
+{
+    bool ret = false;
+
+    for ( uint8_t k = 0; (k < mgl_adc_chan_first[ADC_INSTANCE_COUNT]) && (ret == false); ++k )
+    {
+        if (mgl_adc_chan_ref[k].result_index == (uint8_t)pin)
+        {
+            *ptr_instance = adc_config_tbl[pin].adc_instance;
+#if ADC_DMA_RESULTS
+            *ptr_index = mgl_adc_chan_ref[k].adc_channel;
+#else
+            *ptr_index = mgl_adc_chan_ref[k].source_index;
+#endif
+            ret = true;
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Uses the segments of adc_cal_cache_load, so it can be called from the frame interrupt.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint16_t adc_get_cal_of_digit(enum_adc_pin_name pin, uint16_t digit)
+{
+    uint16_t ret = digit;
+
+    if ( (pin < ADC_MAX) && (ADC_CAL_STATE_VALID == mgl_adc_cal[pin].state) )
+    {
+        ret = adc_cal_apply(&mgl_adc_cal[pin], digit);
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The buffer of the last sequence number is copied and its sequence number is checked afterwards. If the
+* producer has started to overwrite the buffer meanwhile, the copy is repeated with the new frame.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+bool adc_get_snapshot(struct_adc_frame_t *ptr_frame)
+{
+    bool ret = false;
+
+    for ( uint8_t retry = 0; (ptr_frame != NULL) && (retry < ADC_FRAME_READ_RETRIES) && (ret == false); retry++ )
+    {
+        const uint32_t seq = mgl_adc_frame_seq;
+        const struct_adc_frame_t *ptr_src = &mgl_adc_frame[seq % ADC_FRAME_BUFFER_N];
+
+        if (seq == 0u)
+        {
+            break;
+        }
+
+        ADC_FRAME_BARRIER();
+        *ptr_frame = *ptr_src;
+        ADC_FRAME_BARRIER();
+        ret = (ptr_src->seq == seq);
+        ptr_frame->seq = seq;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Same as adc_get_snapshot, but only the requested channels are copied.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+bool adc_get_snapshot_channels(const enum_adc_pin_name *ptr_pins, uint8_t cnt, struct_adc_results_t *ptr_results, uint32_t *ptr_seq)
+{
+    bool ret = false;
+
+    for ( uint8_t retry = 0; (ptr_pins != NULL) && (ptr_results != NULL) && (retry < ADC_FRAME_READ_RETRIES) && (ret == false); retry++ )
+    {
+        const uint32_t seq = mgl_adc_frame_seq;
+        const struct_adc_frame_t *ptr_src = &mgl_adc_frame[seq % ADC_FRAME_BUFFER_N];
+
+        if (seq == 0u)
+        {
+            break;
+        }
+
+        ADC_FRAME_BARRIER();
+        for ( uint8_t k = 0; k < cnt; ++k )
+        {
+            ptr_results[k] = (ptr_pins[k] < ADC_MAX) ? ptr_src->results[ptr_pins[k]] : (struct_adc_results_t){0};
+        }
+        ADC_FRAME_BARRIER();
+        ret = (ptr_src->seq == seq);
+
+        if ( (ret) && (ptr_seq != NULL) )
+        {
+            *ptr_seq = seq;
+        }
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Only compares the sequence numbers, mgl_adc_frame_seq is one aligned word.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+bool adc_frame_is_newer(uint32_t *ptr_seq)
+{
+    bool ret = false;
+
+    if (ptr_seq != NULL)
+    {
+        const uint32_t seq = mgl_adc_frame_seq;
+
+        if (seq != *ptr_seq)
+        {
+            *ptr_seq = seq;
+            ret = true;
+        }
+    }
+
+    return ret;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+*  Returns the two-byte module identifier which is sitting at address 0
+*  of calibration table
+*
+*/
+uint16_t adc_get_module_type()
+{
+    // The first record (uint16_t) keeps the module identifier
+    uint16_t *ptr = (uint16_t*)ee_read(CALIBR_EE_TABLE_MODULE_ADDR);
+    uint16_t tmp = (NULL != ptr) ? (*ptr) : 0u;
+    return tmp;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* This function is used to copy the ADC results from the ADC interrupt to a structure element which can be used for further processing
+* without disabling the ADC interrupts again.
+*
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20210218   | Author  | jallgeier
+*/
+void adc_copy_results_from_interrupt(uint8_t adc_instance, uint8_t* adc_done_flag, uint32_t* adc_counter, IRQn_Type adc_interrupt )
+{
+    uint32_t tmp_counter = mgl_adc_counter[adc_instance]; //get the global adc interrupt counter.
+    bool consistent = false;
+
+    //check if there are new ADC values available
+    if (tmp_counter != *adc_counter)
+    {
+        //Set a flag to indicate that new adc values are available
+        *adc_done_flag = 1;
+
+        //The interrupt (or eDMA callback) writes the values of a frame before it increments the counter. If the
+        //counter hasn't changed during the copy, the values belong to one frame and the interrupt needn't be disabled.
+        for ( uint8_t retry = 0; (retry < ADC_FRAME_READ_RETRIES) && (consistent == false); retry++ )
+        {
+            ADC_FRAME_BARRIER();
+            adc_copy_instance_results(adc_instance);
+            ADC_FRAME_BARRIER();
+            consistent = (mgl_adc_counter[adc_instance] == tmp_counter);
+            tmp_counter = mgl_adc_counter[adc_instance];
+        }
+
+        //the frames follow each other too fast for the copy
+        if (consistent == false)
+        {
+            INT_SYS_DisableIRQ(adc_interrupt);
+            tmp_counter = mgl_adc_counter[adc_instance];
+            adc_copy_instance_results(adc_instance);
+            INT_SYS_EnableIRQ(adc_interrupt);
+        }
+        *adc_counter = tmp_counter; // set the local adc_counter to the same value as the temporary adc counter
+    }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+*  needs to be called periodically, ideally after each ADC cycle is completed to ensure calibrated values and raw adc samples are in sync
+*
+* \internal
+* \endinternal
+*
+*/
+void adc_processing(uint8_t *multiplex_group, bool hw_calibration_support)
+{
+    static uint32_t adc1_counter = 0, adc2_counter = 0;//local counter which contains the value of the global adc interrupt counter
+    uint8_t adc_inst1_done = 0, adc_inst2_done = 0;//flag which indicates that new ADC values are available.
+    static uint32_t multiplex_adc1_counter = 0, multiplex_adc2_counter = 0; //multiplex counter which are used for stability purpose
+    bool adc1_stability_cnt_passed = FALSE, adc2_stability_cnt_passed = FALSE; //bool variables to make IF queries clearer
+
+    adc_copy_results_from_interrupt(INST_ADCONV1, &adc_inst1_done, &adc1_counter, ADC_RESULT_IRQN_ADCONV1);
+    adc_copy_results_from_interrupt(INST_ADCONV2, &adc_inst2_done, &adc2_counter, ADC_RESULT_IRQN_ADCONV2);
+
+    //Depending on the size of the capacitors at the analog input, a small residual from
+    //the previous selected input may be measured during multiplex switching. To give the
+    //capacitor enough time to discharge, some ADC measurements to the corresponding channel
+    //are "discarded" and only every MULTIPLEX_STABILITY_CYCLES measurement is stored.
+    adc1_stability_cnt_passed = (((adc1_counter) - (multiplex_adc1_counter)) >= MULTIPLEX_STABILITY_CYCLES);
+    adc2_stability_cnt_passed = (((adc2_counter) - (multiplex_adc2_counter)) >= MULTIPLEX_STABILITY_CYCLES);
+
+    //the bootloader protocol may have changed the calibration values
+    if (hw_calibration_support)
+    {
+        adc_cal_cache_check();
+    }
+
+    if (adc_inst1_done == 1 || adc_inst2_done == 1)
+    {
+        // ---------------------------------------------------------------------------------------------------
+        // Copying of the raw ADC values into the DIGITS results vector with distinction which multiplex group is currently selected.
+        // ---------------------------------------------------------------------------------------------------
+        for ( uint8_t k = 0; k < mgl_adc_direct_cnt; ++k )
+        {
+            adc_results[mgl_adc_direct_idx[k]].result_digit = adc_results[mgl_adc_direct_idx[k]].result_raw;
+        }
+
+        //only the inputs of the currently selected multiplex group are valid.
+        //WARNING if the multiplex should ever wanted to be decouple, this code wouldn't work anymore.
+        if ( (*multiplex_group < ADC_MUX_GROUP_N) && (adc1_stability_cnt_passed && adc2_stability_cnt_passed) )
+        {
+            for ( uint8_t k = mgl_adc_mux_first[*multiplex_group]; k < mgl_adc_mux_first[*multiplex_group + 1u]; ++k )
+            {
+                adc_results[mgl_adc_mux_idx[k]].result_digit = adc_results[mgl_adc_mux_idx[k]].result_raw;
+            }
+        }
+
+        for ( uint8_t i = 0; i < ADC_MAX; ++i )
+        {
+            // ---------------------------------------------------------------------------------------------------
+            // Die Zuweisung der Gewichteten Werte ist aktuell noch auskommentiert. Grund ist die Laufzeit von ca.
+            // 85 us(+47% Gesamtlaufzeit) bei 38 ADC Channels bei der CC16. Aktuell befindet sich diese Zuweisung+Berechnung
+            // in der get_mV Funktion. Ziel der Berechnung an dieser Stelle ist, zum einen eine bessere Uebersicht
+            // zum Anderen, sollten im Falle vorhandener Kalibrierwerte, diese im Nachhinein in die result_unit
+            // geschrieben werden.
+            // ---------------------------------------------------------------------------------------------------
+            //adc_results[i].result_unit = ((adc_results[i].result_digit * adc_get_measurement_range(i)) / adc_config_tbl[i].resolution);
+
+            // ---------------------------------------------------------------------------------------------------
+            // Calibration part. Not every module has calibrated values, so in this case some code parts must not be executed. (to reduce runtime overhead)
+            // ---------------------------------------------------------------------------------------------------
             if(hw_calibration_support)
             {
                 //check the calibration type of the input. If the type is NONE, nothing at all is executed - there is no else case.
                 if ( adc_config_tbl[i].cal_type != CALIB_NONE )
                 {
-                    int16_t *ptr = (int16_t*) ee_read(CALIBR_EE_TABLE_DATA_ADDR + adc_config_tbl[i].cal_index);
-
                     //check if there are calibrated values saved on this eeprom area. If not return a '0'
-                    if ( NULL == ptr || -1 == *ptr )
+                    if ( ADC_CAL_STATE_EMPTY == mgl_adc_cal[i].state )
                     {
                         adc_results[i].result_cal = 0;
-                        adc_results[i].result_filtered = (adc_results[i].result_filtered*(AD_FILTER-1) + adc_results[i].result_digit) / AD_FILTER;
+                        adc_results[i].result_filtered = adc_filter_update((enum_adc_pin_name)i, adc_results[i].result_digit);
                     }
                     else
                     {
-                        //switch case, executes lookup function with parameters depending which calibrate type is selected.
-                        switch ( adc_config_tbl[i].cal_type )
+                        //the segments of CALIB_SOURCE_3P and CALIB_SOURCE_SINK_3P have been prepared by adc_cal_cache_load().
+                        //Other types return 0 as result to not leave users in the false hope of the values actually being calibrated.
+                        if ( ADC_CAL_STATE_VALID == mgl_adc_cal[i].state )
                         {
-                            case CALIB_SOURCE_3P: //Only three source or sink points are available. So only the number of points is relevant.
-                                number_points = 3;
-                                adc_results[i].result_cal = os_util_lookup1D(ptr, ptr + number_points, number_points,adc_results[i].result_digit, LUT_MODE_EXTRAPOLATION_POS);
-                                break;
-
-                            case CALIB_SOURCE_SINK_3P: //There are three source points AND three sink points.
-                                number_points = 3;
-                                //todo: for now, this case looks like the "CALIB_SOURCE_3P" because we ignore the saved sink values and this will be reconstructed when adapting the measurement.
-                                    adc_results[i].result_cal = os_util_lookup1D(ptr, ptr + number_points, number_points,adc_results[i].result_digit, LUT_MODE_EXTRAPOLATION_POS);
-                                break;
-
-                            default: //default state. We should never reach here, if we do return 0 as result to not leave users in the false hope of the values actually being calibrated.
-                                adc_results[i].result_cal = 0;
-                                break;
-
+                            adc_results[i].result_cal = adc_cal_apply(&mgl_adc_cal[i], adc_results[i].result_digit);
+                        }
+                        else
+                        {
+                            adc_results[i].result_cal = 0;
                         }
-                        adc_results[i].result_filtered = (adc_results[i].result_filtered*(AD_FILTER-1) + adc_results[i].result_cal) / AD_FILTER;
+                        adc_results[i].result_filtered = adc_filter_update((enum_adc_pin_name)i, adc_results[i].result_cal);
                     }
                 }
             }
             else
             {
-                adc_results[i].result_filtered = (adc_results[i].result_filtered*(AD_FILTER-1) + adc_results[i].result_digit) / AD_FILTER;
+                adc_results[i].result_filtered = adc_filter_update((enum_adc_pin_name)i, adc_results[i].result_digit);
             }
         }
 #if FLOATING_AVG
@@ -457,21 +1679,56 @@ void adc_processing(uint8_t *multiplex_group, bool hw_calibration_support)
             mgl_mean_current_value[i].current_value = adc_calc_float_avg(&mean_filter_data[i]);
         }
 #endif
+
+        // all channels of this cycle are complete
+        adc_frame_publish(*multiplex_group);
     }
 
     //check if there have been past enough ADC cycles, so that it is save to swap the multiplex channel.
     if ( (adc1_stability_cnt_passed) && (adc2_stability_cnt_passed) )
     {
-        //"reset" of the multiplex counter
-        multiplex_adc1_counter = adc1_counter;
-        multiplex_adc2_counter = adc2_counter;
-        //change the multiplex group
-        *multiplex_group = (1 + *multiplex_group) % (mgl_multiplex_group_max + 1);
-        //call of the adc multiplexing modulhardware code
-        modulhardwarecode_adc_multiplex(*multiplex_group);
+        //select the next group by priority and refresh period. If no other group is due, the current one stays
+        //selected and its values are taken over with every new ADC cycle.
+        uint8_t next_group = adc_mux_schedule(*multiplex_group, (adc_inst1_done == 1 || adc_inst2_done == 1));
+
+        if ( next_group != *multiplex_group )
+        {
+            //"reset" of the multiplex counter
+            multiplex_adc1_counter = adc1_counter;
+            multiplex_adc2_counter = adc2_counter;
+            //change the multiplex group
+            *multiplex_group = next_group;
+            adc_mux_select(*multiplex_group);
+        }
     }
 }
 
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*   Builds the running sum of the floating average again if the window size (amount_of_values) has been changed.
+*   amount_of_values has to be in the range 1..AD_FILTER.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void float_avg_update_window(floating_avg_data_t *float_avg_data)
+{
+	if ( float_avg_data->amount_of_values != float_avg_data->sum_amount )
+	{
+		float_avg_data->sum = 0u;
+		// calculate the sum of all values of the array
+		for ( uint16_t i = 0; i < (float_avg_data->amount_of_values); ++i )
+		{
+			float_avg_data->sum += (uint32_t) float_avg_data->a_data[i];
+		}
+		float_avg_data->sum_amount = float_avg_data->amount_of_values;
+		float_avg_data->index_next_value %= float_avg_data->amount_of_values;
+	}
+}
+
 /*----------------------------------------------------------------------------*/
 /**
 * \internal
@@ -488,6 +1745,11 @@ void add_to_float_avg(floating_avg_data_t *float_avg_data, uint16_t new_value)
 		{
 			float_avg_data->amount_of_values = AD_FILTER;
 		}
+		// the window size has been changed: build the running sum once over the new window
+		float_avg_update_window(float_avg_data);
+		// replace the oldest value in the running sum by the new one
+		float_avg_data->sum -= (uint32_t) float_avg_data->a_data[float_avg_data->index_next_value];
+		float_avg_data->sum += (uint32_t) new_value;
 		// write the new value to the intended position in the array.
 		float_avg_data->a_data[float_avg_data->index_next_value] = new_value;
 		// Der naechste Wert wird dann an die Position dahinter geschrieben.
@@ -495,8 +1757,6 @@ void add_to_float_avg(floating_avg_data_t *float_avg_data, uint16_t new_value)
 		float_avg_data->index_next_value++;
 		// if the maximum amount of the average values is reached, the index counter is set to it's start position.
 		float_avg_data->index_next_value %= float_avg_data->amount_of_values;
-
-		float_avg_data->amount_of_values = 1;
 	}
 	else
 	{
@@ -509,6 +1769,7 @@ void add_to_float_avg(floating_avg_data_t *float_avg_data, uint16_t new_value)
 /**
 * \internal
 * Function that returns the calculated output value of the floating average.
+* The sum is maintained by add_to_float_avg, it is only built here if the window size has been changed since then.
 * \endinternal
 *
 */
@@ -524,14 +1785,9 @@ uint16_t adc_calc_float_avg(floating_avg_data_t *float_avg_data)
 		{
 			float_avg_data->amount_of_values = AD_FILTER;
 		}
-		uint32_t temp_sum = 0;
-		// calculate the sum of all values of the array
-		for ( uint16_t i = 0; i < (float_avg_data->amount_of_values); ++i )
-		{
-			temp_sum += (uint32_t) float_avg_data->a_data[i];
-		}
+		float_avg_update_window(float_avg_data);
 		//divide the calculated sum through the selected amount of value
-		o_Result = (temp_sum / float_avg_data->amount_of_values);
+		o_Result = (float_avg_data->sum / float_avg_data->amount_of_values);
 	}
 	else
 	{
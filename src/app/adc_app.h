@@ -27,6 +27,12 @@
 // ===================================================================================================
 // Defines
 // ===================================================================================================
+#ifndef ADC_DMA_RESULTS
+#define ADC_DMA_RESULTS 0  // 1: eDMA collects the result registers when the PDB cycle is completed, ADC0/ADC1 interrupts are not used
+#endif
+
+#define ADC_FRAME_READ_RETRIES      (4u)    ///< attempts of a lock-free copy before it fails (snapshot) or disables the interrupt (ADC results)
+#define ADC_OVERSAMPLING_BITS_MAX   (4u)    ///< result_hires has up to 12 + 4 = 16 bit
 
 // ===================================================================================================
 // Typedef
@@ -36,6 +42,8 @@ typedef struct
     uint16_t a_data[AD_FILTER];
     uint8_t index_next_value;
     uint16_t amount_of_values;
+    uint16_t sum_amount;        // window size of sum, 0 = sum not built yet
+    uint32_t sum;               // running sum of the first sum_amount elements of a_data
  } floating_avg_data_t;       ///< Typedef that contains the data, which is used to calculate the floating average values.
 
 typedef struct
@@ -51,8 +59,39 @@ typedef struct
         uint16_t result_unit;     // values converted to unit e.g. mV//todo Kommentare anpassen
         uint16_t result_cal;      // calibrated values
         uint16_t result_filtered; // filtered calibrated values (if available). can be in mV or any other unit depending on the hardware.
+        uint16_t result_hires;    // raw value with 12 + n bit, oversampled and decimated over 4^n PDB cycles (see adc_set_oversampling). n = 0: result_raw
 }struct_adc_results_t;
 
+#if ADC_DMA_RESULTS
+typedef uint32_t adc_frame_value_t;     ///< eDMA copy of the result registers of an instance, indexed by control channel
+#else
+typedef uint16_t adc_frame_value_t;     ///< adc_interrupt_values, indexed by the channel which has been read from the ADC
+#endif
+
+typedef struct
+{
+    uint32_t seq;               // sequence number of the frame, incremented by every adc_processing cycle with new values
+    uint32_t timestamp_ms;      // time of the publication
+    uint8_t  multiplex_group;   // multiplex group which was selected during the frame
+    struct_adc_results_t results[ADC_MAX];
+} struct_adc_frame_t;           ///< All channels of one adc_processing cycle, see adc_get_snapshot()
+
+typedef enum
+{
+    ADC_ACQ_PROFILE_STANDARD    = 0u,   ///< single conversion per channel and PDB cycle
+    ADC_ACQ_PROFILE_HWAVG_4         ,   ///< ADC hardware average of 4 conversions, PDB cycle 4 times longer
+    ADC_ACQ_PROFILE_HWAVG_8         ,   ///< ADC hardware average of 8 conversions, PDB cycle 8 times longer
+    ADC_ACQ_PROFILE_HWAVG_16        ,   ///< ADC hardware average of 16 conversions, PDB cycle 16 times longer
+    ADC_ACQ_PROFILE_MAX
+} enum_adc_acq_profile_t;
+
+typedef struct
+{
+    bool          hw_avg_enable;        // ADC hardware averaging on/off
+    adc_average_t hw_avg;               // number of averaged conversions
+    uint16_t      pdb_modulus;          // PDB cycle in PDB clock ticks, the pre-trigger delays of the PDB channels are quarters of it
+} struct_adc_acq_profile_t;
+
 
 extern struct_adc_results_t adc_results[ADC_MAX];
 
@@ -73,13 +112,162 @@ uint16_t get_mean_analog_value_exact(enum_adc_pin_name analog_pin);
 
 uint32_t adc_get_measurement_range(enum_adc_pin_name const pin);
 
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Selects the acquisition profile of both ADC instances.
+* \details  Sets the ADC hardware averaging and the PDB cycle (modulus and pre-trigger delays). The
+*           frame in progress when the profile is changed may contain results of both profiles.
+*
+* \param    profile [in] uint8_t    enum_adc_acq_profile_t
+* \return   bool                    false for an invalid profile
+*/
+bool adc_set_acquisition_profile(uint8_t profile);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Returns the active acquisition profile (enum_adc_acq_profile_t).
+*
+* \return   uint8_t
+*/
+uint8_t adc_get_acquisition_profile(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Selects the oversampling of a channel.
+* \details  4^extra_bits results of consecutive PDB cycles are summed and shifted right by extra_bits, which
+*           gives result_hires with 12 + extra_bits bit. Accumulated in the frame interrupt, so no cycle is lost
+*           if adc_processing is called less often. Only for channels which are not multiplexed.
+*
+* \param    pin         [in] enum_adc_pin_name  channel of adc_config_tbl
+* \param    extra_bits  [in] uint8_t            0..ADC_OVERSAMPLING_BITS_MAX, 0 = off
+* \return   bool                                false for a multiplexed channel or invalid parameters
+*/
+bool adc_set_oversampling(enum_adc_pin_name pin, uint8_t extra_bits);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Returns the nominal update rate of result_hires of a channel in mHz.
+* \details  PDB clock / PDB modulus of the acquisition profile, divided by 4^extra_bits of the oversampling.
+*           The interrupt latency between two PDB cycles is not included. For multiplexed channels the achieved
+*           refresh rate of the group is returned (see adc_mux_get_refresh_rate_mhz).
+*
+* \param    pin [in] enum_adc_pin_name  channel of adc_config_tbl
+* \return   uint32_t                    samples per 1000 s
+*/
+uint32_t adc_get_sample_rate_mhz(enum_adc_pin_name pin);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Sets the schedule of a multiplex group.
+* \details  After MULTIPLEX_STABILITY_CYCLES the next group is selected from the groups whose refresh period
+*           has passed: highest priority first, then the one refreshed longest ago. If no group is due, the
+*           current group stays selected. Default of all groups is priority 0 and period 0 (round-robin).
+*           A high priority group needs a period, otherwise it is always due and the other groups are
+*           not refreshed anymore.
+*
+* \param    group           [in] uint8_t    multiplex group of adc_config_tbl
+* \param    priority        [in] uint8_t    higher value wins
+* \param    period_ms       [in] uint16_t   target refresh period, 0 = as often as possible
+* \param    idle_timeout_ms [in] uint16_t   if none of the channels has been read (user_ai_get...) for this time, the
+*                                           group is only refreshed once per second. 0 = always refreshed
+* \return   bool                            false for an invalid group
+*/
+bool adc_mux_set_group(uint8_t group, uint8_t priority, uint16_t period_ms, uint16_t idle_timeout_ms);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Returns the achieved refresh rate of a multiplex group in mHz, measured over the last second.
+*
+* \param    group [in] uint8_t  multiplex group of adc_config_tbl
+* \return   uint32_t            refreshes per 1000 s
+*/
+uint32_t adc_mux_get_refresh_rate_mhz(uint8_t group);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Marks the multiplex group of a channel as read, see idle_timeout_ms of adc_mux_set_group.
+*
+* \param    pin [in] enum_adc_pin_name  channel of adc_config_tbl, channels which are not multiplexed are ignored
+* \return   void
+*/
+void adc_mux_touch(enum_adc_pin_name pin);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Returns the sequence number of the last frame published by adc_processing, 0 if there is none yet.
+*
+* \return   uint32_t
+*/
+uint32_t adc_frame_get_seq(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Copies the last complete frame of all channels.
+* \details  adc_processing publishes every cycle as a frame in one of two buffers. The copy doesn't disable
+*           any interrupt, so it can be taken in interrupts and in the main loop. All values of the copy
+*           belong to the same cycle, unlike reading adc_results channel by channel.
+*
+* \param    ptr_frame [out] struct_adc_frame_t*   copy of the frame
+* \return   bool                                  false if no frame has been published yet or the copy was
+*                                                 overwritten ADC_FRAME_READ_RETRIES times
+*/
+bool adc_get_snapshot(struct_adc_frame_t *ptr_frame);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Copies some channels of the last complete frame, see adc_get_snapshot.
+*
+* \param    ptr_pins    [in]  const enum_adc_pin_name*   channels
+* \param    cnt         [in]  uint8_t                    number of channels
+* \param    ptr_results [out] struct_adc_results_t*      values, in the order of ptr_pins
+* \param    ptr_seq     [out] uint32_t*                  sequence number of the frame, can be NULL
+* \return   bool                                         false if no frame is available
+*/
+bool adc_get_snapshot_channels(const enum_adc_pin_name *ptr_pins, uint8_t cnt, struct_adc_results_t *ptr_results, uint32_t *ptr_seq);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Checks for a frame newer than *ptr_seq, without waiting.
+* \details  To wait for the next frame, poll it or run a scheduler task which is released by
+*           SCHED_EVT_ADC_FRAME and has a lower priority than the task of adc_processing, it runs after
+*           the frame has been published. Can be called in interrupts.
+*
+* \param    ptr_seq    [in,out] uint32_t*  last known sequence number, set to the new one
+* \return   bool                           true if a newer frame is available
+*/
+bool adc_frame_is_newer(uint32_t *ptr_seq);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Returns where the frame interrupt finds the value of a channel.
+* \details  Used by services which process every PDB cycle (e.g. adc_capture), the frame values of the instance
+*           are passed to them as adc_frame_value_t array.
+*
+* \param    pin          [in]  enum_adc_pin_name  channel of adc_config_tbl
+* \param    ptr_instance [out] uint8_t*           ADC instance
+* \param    ptr_index    [out] uint8_t*           index in the adc_frame_value_t array
+* \return   bool                                  false if the channel isn't converted
+*/
+bool adc_get_frame_index(enum_adc_pin_name pin, uint8_t *ptr_instance, uint8_t *ptr_index);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Calibrated value of a raw value of a channel, e.g. of a frame value.
+*
+* \param    pin     [in] enum_adc_pin_name  channel of adc_config_tbl
+* \param    digit   [in] uint16_t           raw value
+* \return   uint16_t                        like result_cal, digit if the channel has no valid calibration
+*/
+uint16_t adc_get_cal_of_digit(enum_adc_pin_name pin, uint16_t digit);
+
 /*----------------------------------------------------------------------------*/
 /**
 * \ingroup
 * \brief
 * \details
 * This function is used to copy the ADC results from the ADC interrupt to a structure element which can be used for further processing
-* without disabling the ADC interrupts again.
+* without disabling the ADC interrupts again. The copy is checked against the interrupt counter and repeated if a new frame
+* has arrived meanwhile, the interrupt is only disabled if this happens ADC_FRAME_READ_RETRIES times.
 *
 * \pre
 *
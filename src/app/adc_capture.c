@@ -0,0 +1,441 @@
+/*----------------------------------------------------------------------------*/
+/**
+ * \file         adc_capture.c
+ * \brief        Triggered waveform capture of analog inputs
+ * \details      See adc_capture.h
+ * \date         20261019
+ * \author       agent
+ *
+ */
+/*----------------------------------------------------------------------------*/
+#include "adc_capture.h"
+#include "user_api_can.h"
+#include "user_api_uart.h"
+
+// ===================================================================================================
+// Macros
+// ===================================================================================================
+#define ADC_CAPTURE_MASK            (ADC_CAPTURE_DEPTH - 1u)
+
+#if (ADC_CAPTURE_DEPTH & ADC_CAPTURE_MASK) != 0u
+#error "ADC_CAPTURE_DEPTH must be a power of 2"
+#endif
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+typedef struct
+{
+    struct_adc_capture_cfg_t cfg;
+    uint8_t  adc_instance;                      // instance of all channels
+    uint8_t  index[ADC_CAPTURE_CHN_MAX];        // positions of the channels in the frame values, see adc_get_frame_index
+    uint16_t write;                             // next row of the ring
+    uint16_t filled;                            // rows recorded since arming, up to pre
+    uint16_t remaining;                         // rows of the post-trigger window still to record
+    uint16_t start;                             // first row of the finished capture
+    uint16_t last;                              // last value of the trigger channel
+    volatile uint8_t trig_pending;              // set by adc_capture_trigger / adc_capture_pwm_edge
+    volatile uint8_t state;                     // enum_adc_capture_state_t
+} struct_adc_capture_t;
+
+typedef struct
+{
+    uint8_t  out;                               // enum_adc_capture_out_t
+    uint8_t  bus;
+    uint32_t can_id;
+    uint16_t sent;                              // rows sent
+    uint8_t  header_sent;
+    uint8_t  header[8];
+} struct_adc_capture_readout_t;
+
+// ===================================================================================================
+// Global data definitions
+// ===================================================================================================
+static struct_adc_capture_t mgl_adc_capture = {.state = ADC_CAPTURE_IDLE};
+static struct_adc_capture_readout_t mgl_adc_capture_readout;
+static uint16_t mgl_adc_capture_ring[ADC_CAPTURE_DEPTH][ADC_CAPTURE_CHN_MAX];   // rows of raw values, written by adc_capture_frame
+
+// ===================================================================================================
+// Internal function prototypes
+// ===================================================================================================
+static uint8_t adc_capture_trig_check(struct_adc_capture_t *ptr_cap, uint16_t value);
+
+// ===================================================================================================
+// Functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Trigger condition of the current row. The last value of the trigger channel is updated by the caller.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static uint8_t adc_capture_trig_check(struct_adc_capture_t *ptr_cap, uint16_t value)
+{
+    uint8_t ret = FALSE;
+
+    switch (ptr_cap->cfg.trig_type)
+    {
+        case ADC_CAPTURE_TRIG_NOW:
+            ret = TRUE;
+            break;
+
+        case ADC_CAPTURE_TRIG_RISING:
+            ret = ( (ptr_cap->last < ptr_cap->cfg.trig_threshold) && (value >= ptr_cap->cfg.trig_threshold) ) ? TRUE : FALSE;
+            break;
+
+        case ADC_CAPTURE_TRIG_FALLING:
+            ret = ( (ptr_cap->last > ptr_cap->cfg.trig_threshold) && (value <= ptr_cap->cfg.trig_threshold) ) ? TRUE : FALSE;
+            break;
+
+        default:
+            ret = ptr_cap->trig_pending;
+            break;
+    }
+
+    return ret;
+}
+
+// ===================================================================================================
+// Public functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The state is set to IDLE first, so the frame interrupt doesn't use the configuration while it is
+* changed.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t adc_capture_arm(const struct_adc_capture_cfg_t *ptr_cfg)
+{
+    uint8_t ret = TRUE;
+    uint8_t instance = 0u;
+    uint8_t index = 0u;
+
+    mgl_adc_capture.state = ADC_CAPTURE_IDLE;
+
+    if ( (ptr_cfg == NULL) ||
+         (ptr_cfg->cnt == 0u) || (ptr_cfg->cnt > ADC_CAPTURE_CHN_MAX) ||
+         (ptr_cfg->post == 0u) || (((uint32_t)ptr_cfg->pre + ptr_cfg->post) > ADC_CAPTURE_DEPTH) ||
+         (ptr_cfg->trig_type >= ADC_CAPTURE_TRIG_MAX) ||
+         (((ptr_cfg->trig_type == ADC_CAPTURE_TRIG_RISING) || (ptr_cfg->trig_type == ADC_CAPTURE_TRIG_FALLING)) && (ptr_cfg->trig_chn >= ptr_cfg->cnt)) )
+    {
+        ret = FALSE;
+    }
+
+    for (uint8_t k = 0; (ret == TRUE) && (k < ptr_cfg->cnt); k++)
+    {
+        // the rows are recorded with the frames of one instance, multiplexed channels aren't valid in every frame
+        if ( (ptr_cfg->pins[k] >= ADC_MAX) || (adc_config_tbl[ptr_cfg->pins[k]].multiplex) ||
+             (adc_get_frame_index(ptr_cfg->pins[k], &instance, &index) == false) ||
+             ((k > 0u) && (instance != mgl_adc_capture.adc_instance)) )
+        {
+            ret = FALSE;
+        }
+        else
+        {
+            mgl_adc_capture.adc_instance = instance;
+            mgl_adc_capture.index[k] = index;
+        }
+    }
+
+    if (ret == TRUE)
+    {
+        mgl_adc_capture.cfg = *ptr_cfg;
+        mgl_adc_capture.write = 0u;
+        mgl_adc_capture.filled = 0u;
+        mgl_adc_capture.remaining = ptr_cfg->post;
+        mgl_adc_capture.last = (ptr_cfg->trig_type == ADC_CAPTURE_TRIG_FALLING) ? 0u : UINT16_MAX;   // no edge with the first row
+        mgl_adc_capture.trig_pending = FALSE;
+        mgl_adc_capture.state = ADC_CAPTURE_ARMED;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void adc_capture_abort(void)
+{
+    mgl_adc_capture.state = ADC_CAPTURE_IDLE;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t adc_capture_get_state(void)
+{
+    return mgl_adc_capture.state;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void adc_capture_trigger(void)
+{
+    if (mgl_adc_capture.cfg.trig_type == ADC_CAPTURE_TRIG_EXTERNAL)
+    {
+        mgl_adc_capture.trig_pending = TRUE;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void adc_capture_pwm_edge(uint8_t module)
+{
+    if ( (mgl_adc_capture.state == ADC_CAPTURE_ARMED) &&
+         (mgl_adc_capture.cfg.trig_type == ADC_CAPTURE_TRIG_PWM) && (mgl_adc_capture.cfg.trig_chn == module) )
+    {
+        mgl_adc_capture.trig_pending = TRUE;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Runs in the frame interrupt: a copy of up to ADC_CAPTURE_CHN_MAX values and a compare. The ring
+* is written until the post-trigger window is complete, afterwards it is frozen until the next
+* adc_capture_arm.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void adc_capture_frame(uint8_t adc_instance, const adc_frame_value_t *ptr_values)
+{
+    struct_adc_capture_t *ptr_cap = &mgl_adc_capture;
+
+    if ( ((ptr_cap->state == ADC_CAPTURE_ARMED) || (ptr_cap->state == ADC_CAPTURE_TRIGGERED)) && (adc_instance == ptr_cap->adc_instance) )
+    {
+        uint16_t *ptr_row = mgl_adc_capture_ring[ptr_cap->write];
+        uint16_t value;
+
+        for (uint8_t k = 0; k < ptr_cap->cfg.cnt; k++)
+        {
+            ptr_row[k] = (uint16_t)ptr_values[ptr_cap->index[k]];
+        }
+        value = ptr_row[ptr_cap->cfg.trig_chn < ptr_cap->cfg.cnt ? ptr_cap->cfg.trig_chn : 0u];
+
+        if (ptr_cap->state == ADC_CAPTURE_ARMED)
+        {
+            if (ptr_cap->filled < ptr_cap->cfg.pre)
+            {
+                ptr_cap->filled++;
+            }
+            else if (adc_capture_trig_check(ptr_cap, value) == TRUE)
+            {
+                // the trigger row is the first row of the post-trigger window
+                ptr_cap->start = (uint16_t)((ptr_cap->write - ptr_cap->cfg.pre) & ADC_CAPTURE_MASK);
+                ptr_cap->state = ADC_CAPTURE_TRIGGERED;
+            }
+            else
+            {
+                // nothing to do
+            }
+        }
+
+        if (ptr_cap->state == ADC_CAPTURE_TRIGGERED)
+        {
+            ptr_cap->remaining--;
+            if (ptr_cap->remaining == 0u)
+            {
+                ptr_cap->state = ADC_CAPTURE_DONE;
+            }
+        }
+
+        ptr_cap->last = value;
+        ptr_cap->write = (uint16_t)((ptr_cap->write + 1u) & ADC_CAPTURE_MASK);
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t adc_capture_get_sample(uint16_t row, uint16_t *ptr_values)
+{
+    uint8_t ret = FALSE;
+
+    if ( ((mgl_adc_capture.state == ADC_CAPTURE_DONE) || (mgl_adc_capture.state == ADC_CAPTURE_READOUT)) &&
+         (ptr_values != NULL) && (row < (mgl_adc_capture.cfg.pre + mgl_adc_capture.cfg.post)) )
+    {
+        const uint16_t *ptr_row = mgl_adc_capture_ring[(mgl_adc_capture.start + row) & ADC_CAPTURE_MASK];
+
+        for (uint8_t k = 0; k < mgl_adc_capture.cfg.cnt; k++)
+        {
+            ptr_values[k] = ptr_row[k];
+        }
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t adc_capture_readout_start(uint8_t out, uint8_t bus, uint32_t can_id)
+{
+    uint8_t ret = FALSE;
+    struct_adc_capture_readout_t *ptr_rd = &mgl_adc_capture_readout;
+
+    if ( (mgl_adc_capture.state == ADC_CAPTURE_DONE) && ((out == ADC_CAPTURE_OUT_CAN) || (out == ADC_CAPTURE_OUT_UART)) )
+    {
+        ptr_rd->out = out;
+        ptr_rd->bus = bus;
+        ptr_rd->can_id = can_id;
+        ptr_rd->sent = 0u;
+        ptr_rd->header_sent = FALSE;
+        ptr_rd->header[0] = ADC_CAPTURE_HEADER_ID;
+        ptr_rd->header[1] = mgl_adc_capture.cfg.cnt;
+        ptr_rd->header[2] = (uint8_t)(mgl_adc_capture.cfg.pre & 0xFFu);
+        ptr_rd->header[3] = (uint8_t)(mgl_adc_capture.cfg.pre >> 8u);
+        ptr_rd->header[4] = (uint8_t)(mgl_adc_capture.cfg.post & 0xFFu);
+        ptr_rd->header[5] = (uint8_t)(mgl_adc_capture.cfg.post >> 8u);
+        ptr_rd->header[6] = mgl_adc_capture.adc_instance;
+        ptr_rd->header[7] = adc_get_acquisition_profile();
+        mgl_adc_capture.state = ADC_CAPTURE_READOUT;
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The rows are sent directly from the ring, which isn't written in the READOUT state. A transfer which
+* isn't accepted is repeated with the next call. UART transfers end at the end of the ring.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void adc_capture_readout_process(void)
+{
+    struct_adc_capture_readout_t *ptr_rd = &mgl_adc_capture_readout;
+    const uint16_t rows = mgl_adc_capture.cfg.pre + mgl_adc_capture.cfg.post;
+
+    if (mgl_adc_capture.state != ADC_CAPTURE_READOUT)
+    {
+        return;
+    }
+
+    if (ptr_rd->out == ADC_CAPTURE_OUT_CAN)
+    {
+        uint8_t burst = 0u;
+        bool busy = false;
+
+        if (ptr_rd->header_sent == FALSE)
+        {
+            if (user_can_msg_buffer_send(ptr_rd->bus, ptr_rd->can_id, STANDARD_ID, 8u, ptr_rd->header) == HAL_CAN_OK)
+            {
+                ptr_rd->header_sent = TRUE;
+            }
+            else
+            {
+                busy = true;
+            }
+        }
+
+        for (; (busy == false) && (burst < ADC_CAPTURE_CAN_BURST) && (ptr_rd->sent < rows); burst++)
+        {
+            uint16_t *ptr_row = mgl_adc_capture_ring[(mgl_adc_capture.start + ptr_rd->sent) & ADC_CAPTURE_MASK];
+
+            if (user_can_msg_buffer_send(ptr_rd->bus, ptr_rd->can_id + 1u, STANDARD_ID, (uint8_t)(2u * mgl_adc_capture.cfg.cnt), (uint8_t*)ptr_row) == HAL_CAN_OK)
+            {
+                ptr_rd->sent++;
+            }
+            else
+            {
+                busy = true;
+            }
+        }
+    }
+    else
+    {
+        if (ptr_rd->header_sent == FALSE)
+        {
+            if (user_uart_send_buffer(ptr_rd->bus, ptr_rd->header, 8u) == HAL_SCI_OK)
+            {
+                ptr_rd->header_sent = TRUE;
+            }
+        }
+        else if (ptr_rd->sent < rows)
+        {
+            const uint16_t first = (uint16_t)((mgl_adc_capture.start + ptr_rd->sent) & ADC_CAPTURE_MASK);
+            uint16_t cnt = rows - ptr_rd->sent;
+
+            if (cnt > ADC_CAPTURE_UART_ROWS)
+            {
+                cnt = ADC_CAPTURE_UART_ROWS;
+            }
+            if (cnt > (ADC_CAPTURE_DEPTH - first))
+            {
+                cnt = ADC_CAPTURE_DEPTH - first;
+            }
+
+            if (user_uart_send_buffer(ptr_rd->bus, (uint8_t*)mgl_adc_capture_ring[first], (uint8_t)(cnt * sizeof(mgl_adc_capture_ring[0]))) == HAL_SCI_OK)
+            {
+                ptr_rd->sent += cnt;
+            }
+        }
+        else
+        {
+            // nothing to do
+        }
+    }
+
+    if ( (ptr_rd->header_sent == TRUE) && (ptr_rd->sent >= rows) )
+    {
+        mgl_adc_capture.state = ADC_CAPTURE_DONE;
+    }
+}
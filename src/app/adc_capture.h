@@ -0,0 +1,173 @@
+#ifndef __ADC_CAPTURE_H_
+#define __ADC_CAPTURE_H_
+/*----------------------------------------------------------------------------*/
+/**
+* \file         adc_capture.h
+* \brief        Triggered waveform capture of analog inputs
+* \details      Records the raw values of up to ADC_CAPTURE_CHN_MAX channels of one ADC instance with
+*               every PDB cycle into a RAM ring, i.e. at the full sample rate instead of once per
+*               adc_processing. The recording is taken from the frame interrupt (or eDMA callback)
+*               of the instance, which only copies the selected values and checks the trigger.
+*
+*               A capture is armed with a pre-trigger and a post-trigger window. The trigger is
+*               enabled once the pre-trigger window is filled:
+*               - ADC_CAPTURE_TRIG_NOW: immediately
+*               - ADC_CAPTURE_TRIG_RISING / FALLING: a channel crosses a threshold (raw digits)
+*               - ADC_CAPTURE_TRIG_PWM: the period start of a FTM module (FTM overflow interrupt,
+*                 which is enabled for PWM outputs with dither)
+*               - ADC_CAPTURE_TRIG_EXTERNAL: adc_capture_trigger()
+*
+*               The finished capture can be read with adc_capture_get_sample() or sent in bulk
+*               over CAN or UART with adc_capture_readout_start() and adc_capture_readout_process().
+* \date         20261019
+* \author       agent
+*
+*/
+/*----------------------------------------------------------------------------*/
+
+#include "hal_data_types.h"
+#include "io_tables.h"
+#include "adc_app.h"
+
+
+// ===================================================================================================
+// Defines
+// ===================================================================================================
+#define ADC_CAPTURE_CHN_MAX         (4u)        ///< channels of one capture, one row fits into a CAN frame
+#ifndef ADC_CAPTURE_DEPTH
+#define ADC_CAPTURE_DEPTH           (1024u)     ///< rows of the ring (power of 2), RAM = ADC_CAPTURE_DEPTH * ADC_CAPTURE_CHN_MAX * 2 byte
+#endif
+#define ADC_CAPTURE_CAN_BURST       (8u)        ///< CAN frames per adc_capture_readout_process call
+#define ADC_CAPTURE_UART_ROWS       (31u)       ///< rows per UART transfer (31 * 8 = 248 byte)
+#define ADC_CAPTURE_HEADER_ID       (0xACu)     ///< first byte of the readout header
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+typedef enum
+{
+    ADC_CAPTURE_TRIG_NOW        = 0u,   ///< trigger as soon as the pre-trigger window is filled
+    ADC_CAPTURE_TRIG_RISING         ,   ///< trigger channel crosses the threshold upwards
+    ADC_CAPTURE_TRIG_FALLING        ,   ///< trigger channel crosses the threshold downwards
+    ADC_CAPTURE_TRIG_PWM            ,   ///< period start of the FTM module, see adc_capture_pwm_edge
+    ADC_CAPTURE_TRIG_EXTERNAL       ,   ///< adc_capture_trigger()
+    ADC_CAPTURE_TRIG_MAX
+} enum_adc_capture_trig_t;
+
+typedef enum
+{
+    ADC_CAPTURE_IDLE            = 0u,   ///< no capture configured or aborted
+    ADC_CAPTURE_ARMED               ,   ///< recording, waiting for the trigger
+    ADC_CAPTURE_TRIGGERED           ,   ///< recording the post-trigger window
+    ADC_CAPTURE_DONE                ,   ///< capture complete, ring is frozen
+    ADC_CAPTURE_READOUT                 ///< capture is being sent, ring is frozen
+} enum_adc_capture_state_t;
+
+typedef enum
+{
+    ADC_CAPTURE_OUT_CAN         = 0u,   ///< header on can_id, one row per frame on can_id + 1
+    ADC_CAPTURE_OUT_UART                ///< header and rows of ADC_CAPTURE_CHN_MAX * 2 byte (little endian)
+} enum_adc_capture_out_t;
+
+typedef struct
+{
+    enum_adc_pin_name pins[ADC_CAPTURE_CHN_MAX];    ///< channels, not multiplexed and on the same ADC instance
+    uint8_t  cnt;                                   ///< number of channels
+    uint16_t pre;                                   ///< rows in front of the trigger
+    uint16_t post;                                  ///< rows from the trigger on (including the trigger row), pre + post <= ADC_CAPTURE_DEPTH
+    uint8_t  trig_type;                             ///< enum_adc_capture_trig_t
+    uint8_t  trig_chn;                              ///< RISING/FALLING: index in pins, PWM: FTM module
+    uint16_t trig_threshold;                        ///< RISING/FALLING: raw digits
+} struct_adc_capture_cfg_t;
+
+// ===================================================================================================
+// Public function prototypes
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Configures and arms a capture. A running capture or readout is aborted.
+*
+* \param    ptr_cfg [in] const struct_adc_capture_cfg_t*   configuration
+* \return   uint8_t                                         TRUE if the configuration is valid and the capture is armed
+*/
+uint8_t adc_capture_arm(const struct_adc_capture_cfg_t *ptr_cfg);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Stops the capture or readout, the state becomes ADC_CAPTURE_IDLE.
+*
+* \return   void
+*/
+void adc_capture_abort(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Returns the state of the capture (enum_adc_capture_state_t).
+*
+* \return   uint8_t
+*/
+uint8_t adc_capture_get_state(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Trigger for ADC_CAPTURE_TRIG_EXTERNAL. Can be called from interrupts.
+* \details  A trigger in front of the filled pre-trigger window is kept until the window is filled.
+*
+* \return   void
+*/
+void adc_capture_trigger(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Trigger source of ADC_CAPTURE_TRIG_PWM, called by the FTM overflow interrupt.
+*
+* \param    module [in] uint8_t     FTM module
+* \return   void
+*/
+void adc_capture_pwm_edge(uint8_t module);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Records a frame of an ADC instance. Called by the frame interrupt / eDMA callback of adc_app.
+*
+* \param    adc_instance [in] uint8_t                   ADC instance of the frame
+* \param    ptr_values   [in] const adc_frame_value_t*  values of the frame, see adc_get_frame_index
+* \return   void
+*/
+void adc_capture_frame(uint8_t adc_instance, const adc_frame_value_t *ptr_values);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Reads one row of a finished capture.
+*
+* \param    row         [in]  uint16_t  0 .. pre + post - 1, the trigger is at row pre
+* \param    ptr_values  [out] uint16_t* raw values of the channels, in the order of the configuration
+* \return   uint8_t                     FALSE if the capture isn't finished or row is invalid
+*/
+uint8_t adc_capture_get_sample(uint16_t row, uint16_t *ptr_values);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Starts sending a finished capture.
+* \details  The 8 byte header contains ADC_CAPTURE_HEADER_ID, the number of channels, pre and post (16 bit,
+*           little endian), the ADC instance and the acquisition profile (see adc_get_sample_rate_mhz for
+*           the PDB cycle). The rows follow, oldest first.
+*
+* \param    out     [in] uint8_t    enum_adc_capture_out_t
+* \param    bus     [in] uint8_t    CAN bus or UART interface
+* \param    can_id  [in] uint32_t   standard CAN-ID of the header, the rows are sent on can_id + 1
+* \return   uint8_t                 FALSE if no finished capture is available
+*/
+uint8_t adc_capture_readout_start(uint8_t out, uint8_t bus, uint32_t can_id);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Sends the next part of the capture, to be called in the main loop.
+* \details  After the last row the state returns to ADC_CAPTURE_DONE, so the capture can be sent again.
+*
+* \return   void
+*/
+void adc_capture_readout_process(void);
+
+#endif
@@ -0,0 +1,197 @@
+/*----------------------------------------------------------------------------*/
+/**
+ * \file         adc_filter.c
+ * \brief        Per channel filters of the analog inputs
+ * \details      See adc_filter.h
+ * \date         20261019
+ * \author       agent
+ *
+ */
+/*----------------------------------------------------------------------------*/
+#include "adc_filter.h"
+
+// ===================================================================================================
+// Macros
+// ===================================================================================================
+#define ADC_FILTER_SWAP_IF_GREATER(a, b)    do { if ((a) > (b)) { uint16_t tmp_ = (a); (a) = (b); (b) = tmp_; } } while (0)
+
+// ===================================================================================================
+// Global data definitions
+// ===================================================================================================
+static struct_adc_filter_t mgl_adc_filter[ADC_MAX];
+
+// ===================================================================================================
+// Internal function prototypes
+// ===================================================================================================
+static uint16_t adc_filter_median(struct_adc_filter_t *ptr_flt, uint16_t value);
+
+// ===================================================================================================
+// Functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Median of the last 3 or 5 samples. The buffer is copied and sorted with a fixed compare/swap
+* network, so the run time doesn't depend on the values.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static uint16_t adc_filter_median(struct_adc_filter_t *ptr_flt, uint16_t value)
+{
+    uint16_t a, b, c, d, e;
+    uint16_t ret;
+
+    ptr_flt->median_buf[ptr_flt->median_idx] = value;
+    ptr_flt->median_idx++;
+    if (ptr_flt->median_idx >= ptr_flt->cfg.median)
+    {
+        ptr_flt->median_idx = 0u;
+    }
+
+    a = ptr_flt->median_buf[0];
+    b = ptr_flt->median_buf[1];
+    c = ptr_flt->median_buf[2];
+
+    if (ptr_flt->cfg.median == 3u)
+    {
+        ADC_FILTER_SWAP_IF_GREATER(a, b);
+        ADC_FILTER_SWAP_IF_GREATER(b, c);
+        ADC_FILTER_SWAP_IF_GREATER(a, b);
+        ret = b;
+    }
+    else
+    {
+        // 7 compare/swaps, only the middle position is sorted afterwards
+        d = ptr_flt->median_buf[3];
+        e = ptr_flt->median_buf[4];
+        ADC_FILTER_SWAP_IF_GREATER(a, b);
+        ADC_FILTER_SWAP_IF_GREATER(d, e);
+        ADC_FILTER_SWAP_IF_GREATER(a, d);
+        ADC_FILTER_SWAP_IF_GREATER(b, e);
+        ADC_FILTER_SWAP_IF_GREATER(b, c);
+        ADC_FILTER_SWAP_IF_GREATER(c, d);
+        ADC_FILTER_SWAP_IF_GREATER(b, c);
+        ret = c;
+    }
+
+    return ret;
+}
+
+// ===================================================================================================
+// Public functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void adc_filter_init(void)
+{
+    for (uint8_t i = 0; i < ADC_MAX; i++)
+    {
+        (void)adc_filter_set((enum_adc_pin_name)i, ADC_FILTER_DEFAULT_TYPE, ADC_FILTER_DEFAULT_SHIFT, 0u);
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t adc_filter_set(enum_adc_pin_name pin, uint8_t type, uint8_t shift, uint8_t median)
+{
+    uint8_t ret = FALSE;
+
+    if ( (pin < ADC_MAX) &&
+         (type < ADC_FILTER_MAX) &&
+         ((type != ADC_FILTER_AVG) || (shift <= ADC_FILTER_AVG_SHIFT_MAX)) &&
+         ((type != ADC_FILTER_IIR) || (shift <= ADC_FILTER_IIR_SHIFT_MAX)) &&
+         ((median == 0u) || (median == 3u) || (median == 5u)) )
+    {
+        mgl_adc_filter[pin].cfg.type = type;
+        mgl_adc_filter[pin].cfg.shift = shift;
+        mgl_adc_filter[pin].cfg.median = median;
+        mgl_adc_filter[pin].primed = FALSE;
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The first sample after adc_filter_set fills the median and average buffers, so the output starts
+* at the input value instead of ramping up from 0.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint16_t adc_filter_update(enum_adc_pin_name pin, uint16_t value)
+{
+    struct_adc_filter_t *ptr_flt = &mgl_adc_filter[pin];
+    const uint8_t shift = ptr_flt->cfg.shift;
+    uint16_t ret = value;
+
+    if (ptr_flt->primed == FALSE)
+    {
+        for (uint8_t k = 0; k < ADC_FILTER_MEDIAN_N; k++)
+        {
+            ptr_flt->median_buf[k] = value;
+        }
+        for (uint8_t k = 0; k < ADC_FILTER_AVG_N; k++)
+        {
+            ptr_flt->avg_buf[k] = value;
+        }
+        ptr_flt->median_idx = 0u;
+        ptr_flt->avg_idx = 0u;
+        ptr_flt->state = (ptr_flt->cfg.type == ADC_FILTER_AVG) ? ((uint32_t)value << shift) : ((uint32_t)value << ADC_FILTER_IIR_FRAC);
+        ptr_flt->primed = TRUE;
+    }
+
+    if (ptr_flt->cfg.median != 0u)
+    {
+        value = adc_filter_median(ptr_flt, value);
+    }
+
+    switch (ptr_flt->cfg.type)
+    {
+        case ADC_FILTER_AVG:
+            // sum of the last 2^shift samples: add the new one, remove the one which drops out of the window
+            ptr_flt->state += (uint32_t)value - ptr_flt->avg_buf[ptr_flt->avg_idx];
+            ptr_flt->avg_buf[ptr_flt->avg_idx] = value;
+            ptr_flt->avg_idx = (uint8_t)((ptr_flt->avg_idx + 1u) & ((1u << shift) - 1u));
+            ret = (uint16_t)((ptr_flt->state + ((1u << shift) >> 1u)) >> shift);
+            break;
+
+        case ADC_FILTER_IIR:
+        {
+            // y += (x - y) >> shift, signed difference with ADC_FILTER_IIR_FRAC fractional bits
+            int32_t diff = (int32_t)((uint32_t)value << ADC_FILTER_IIR_FRAC) - (int32_t)ptr_flt->state;
+            ptr_flt->state = (uint32_t)((int32_t)ptr_flt->state + (diff >> shift));
+            ret = (uint16_t)((ptr_flt->state + ((1u << ADC_FILTER_IIR_FRAC) >> 1u)) >> ADC_FILTER_IIR_FRAC);
+            break;
+        }
+
+        default:
+            ret = value;
+            break;
+    }
+
+    return ret;
+}
@@ -0,0 +1,109 @@
+#ifndef __ADC_FILTER_H_
+#define __ADC_FILTER_H_
+/*----------------------------------------------------------------------------*/
+/**
+* \file         adc_filter.h
+* \brief        Per channel filters of the analog inputs
+* \details      Every channel of adc_config_tbl has its own filter which is updated by adc_processing
+*               with each new result_cal (or result_digit for channels without calibration values)
+*               and written to result_filtered. All filters need constant time per sample and no
+*               division:
+*               - ADC_FILTER_AVG: moving average over 2^shift samples with a running sum
+*               - ADC_FILTER_IIR: first order low pass, y += (x - y) / 2^shift
+*               - optional median over 3 or 5 samples in front of both for spike rejection
+*
+*               adc_config_tbl is generated by the DS, so the default of all channels is derived
+*               from AD_FILTER (modulhardwarecode.h) and can be changed per channel with
+*               adc_filter_set().
+* \date         20261019
+* \author       agent
+*
+*/
+/*----------------------------------------------------------------------------*/
+
+#include "hal_data_types.h"
+#include "io_tables.h"
+#include "modulhardwarecode.h"
+
+
+// ===================================================================================================
+// Defines
+// ===================================================================================================
+#ifndef ADC_FILTER_AVG_SHIFT_MAX
+#define ADC_FILTER_AVG_SHIFT_MAX    (4u)                            ///< Largest moving average window is 2^4 = 16 samples (RAM per channel).
+#endif
+#define ADC_FILTER_AVG_N            (1u << ADC_FILTER_AVG_SHIFT_MAX)
+#define ADC_FILTER_IIR_SHIFT_MAX    (8u)                            ///< Smallest IIR coefficient is 1/256.
+#define ADC_FILTER_IIR_FRAC         ADC_FILTER_IIR_SHIFT_MAX        ///< Fractional bits of the IIR state, keeps the dead band of (x - y) >> shift below 1 digit.
+#define ADC_FILTER_MEDIAN_N         (5u)                            ///< Largest median window
+
+/** Default of all channels: the IIR of AD_FILTER with the nearest power of two coefficient, no filter for AD_FILTER = 1. */
+#define ADC_FILTER_DEFAULT_SHIFT    ((AD_FILTER >= 12u) ? 4u : (AD_FILTER >= 6u) ? 3u : (AD_FILTER >= 3u) ? 2u : (AD_FILTER >= 2u) ? 1u : 0u)
+#define ADC_FILTER_DEFAULT_TYPE     ((ADC_FILTER_DEFAULT_SHIFT > 0u) ? ADC_FILTER_IIR : ADC_FILTER_NONE)
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+typedef enum
+{
+    ADC_FILTER_NONE             = 0u,   ///< result_filtered follows the input
+    ADC_FILTER_AVG                  ,   ///< moving average over 2^shift samples, shift 0..ADC_FILTER_AVG_SHIFT_MAX
+    ADC_FILTER_IIR                  ,   ///< first order low pass with coefficient 1/2^shift, shift 0..ADC_FILTER_IIR_SHIFT_MAX
+    ADC_FILTER_MAX
+} enum_adc_filter_type_t;
+
+typedef struct
+{
+    uint8_t type;                           ///< enum_adc_filter_type_t
+    uint8_t shift;                          ///< window 2^shift (AVG) or coefficient 1/2^shift (IIR)
+    uint8_t median;                         ///< 0 (off), 3 or 5 samples median in front of the filter
+} struct_adc_filter_cfg_t;
+
+typedef struct
+{
+    struct_adc_filter_cfg_t cfg;
+    uint8_t  primed;                        ///< FALSE until the first sample, which initializes all buffers
+    uint8_t  median_idx;                    ///< next position in median_buf
+    uint8_t  avg_idx;                       ///< next position in avg_buf
+    uint16_t median_buf[ADC_FILTER_MEDIAN_N];
+    uint16_t avg_buf[ADC_FILTER_AVG_N];
+    uint32_t state;                         ///< running sum (AVG) or output with ADC_FILTER_IIR_FRAC fractional bits (IIR)
+} struct_adc_filter_t;
+
+// ===================================================================================================
+// Public function prototypes
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Sets all channels to the default filter (see ADC_FILTER_DEFAULT_TYPE).
+*
+* \return   void
+*/
+void adc_filter_init(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Changes the filter of one channel.
+* \details  The filter starts again with the next sample. Must not be called while adc_processing runs,
+*           i.e. from an interrupt.
+*
+* \param    pin     [in] enum_adc_pin_name  channel of adc_config_tbl
+* \param    type    [in] uint8_t            enum_adc_filter_type_t
+* \param    shift   [in] uint8_t            window 2^shift (AVG) or coefficient 1/2^shift (IIR)
+* \param    median  [in] uint8_t            0, 3 or 5
+* \return   uint8_t                         TRUE if the configuration is valid and has been taken over
+*/
+uint8_t adc_filter_set(enum_adc_pin_name pin, uint8_t type, uint8_t shift, uint8_t median);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Filters one sample of a channel.
+*
+* \param    pin     [in] enum_adc_pin_name  channel of adc_config_tbl
+* \param    value   [in] uint16_t           new sample
+* \return   uint16_t                        filter output
+*/
+uint16_t adc_filter_update(enum_adc_pin_name pin, uint16_t value);
+
+#endif
@@ -17,10 +17,14 @@
 #include "hal_io.h"
 #include "user_code.h"
 #include "can_db_tables.h"
+#include "sched_app.h"
+#include "prof_app.h"
+#include "time_app.h"
 
 #define MAX_CAN_BUS_SUPPORTED 3
 
 volatile struct_can_app_error can_error_handle[MAX_CAN_BUS_SUPPORTED];
+volatile uint64_t can_rx_timestamp_us[MAX_CAN_BUS_SUPPORTED];     // time_app us of the last received frame per bus
 
 
 /**
@@ -239,6 +243,8 @@ uint32_t user_can_fd_calculate_baudrate(uint32_t arb_baud, uint32_t arb_sample_p
 
 void CAN_Callback(uint8_t instance, flexcan_event_type_t eventType, uint32_t buffIdx, flexcan_state_t *flexcanState)
 {
+    PROF_APP_BEGIN(PROF_SEC_ISR_CAN);
+
     struct_sfl_can_fifo_frame can_msg_receive;
     can_msg_receive.header.ptr_data = can_msg_receive.data;
 
@@ -259,21 +265,30 @@ void CAN_Callback(uint8_t instance, flexcan_event_type_t eventType, uint32_t buf
         	{
                 // get received can msg, re-enable the FIFO receive interrupt
                 hal_can_receive(&can_handle, &can_msg_receive.header);
+                // reception time for latency measurements
+                can_rx_timestamp_us[instance] = time_app_now_us();
                 // Take over the data to db
                 sfl_can_db_rx_wrapper(instance, &can_msg_receive.header);
+                // release the CAN input task of the main loop
+                sched_app_event_post(SCHED_EVT_CAN_RX);
         	}
         	else
         	{
-        		// do nothing
+        		// the frame has been handed to the bootloader protocol, release its task
+        		sched_app_event_post(SCHED_EVT_CAN_RX);
         	}
             break;
         default:
             break;
     }
+
+    PROF_APP_END(PROF_SEC_ISR_CAN);
 }
 
 void CAN2_Callback(uint8_t instance, flexcan_event_type_t eventType, uint32_t buffIdx, flexcan_state_t *flexcanState)
 {
+    PROF_APP_BEGIN(PROF_SEC_ISR_CAN);
+
     struct_sfl_can_fifo_frame can_msg_receive;
     can_msg_receive.header.ptr_data = can_msg_receive.data;
 
@@ -295,21 +310,30 @@ void CAN2_Callback(uint8_t instance, flexcan_event_type_t eventType, uint32_t bu
         	{
 				// get received can msg, re-enable the FIFO receive interrupt
 				hal_can_receive(&can_handle, &can_msg_receive.header);
+				// reception time for latency measurements
+				can_rx_timestamp_us[instance] = time_app_now_us();
 				// Take over the data to db
 				sfl_can_db_rx_wrapper(instance, &can_msg_receive.header);
+				// release the CAN input task of the main loop
+				sched_app_event_post(SCHED_EVT_CAN_RX);
         	}
         	else
         	{
-        		// do nothing
+        		// the frame has been handed to the bootloader protocol, release its task
+        		sched_app_event_post(SCHED_EVT_CAN_RX);
         	}
             break;
         default:
             break;
     }
+
+    PROF_APP_END(PROF_SEC_ISR_CAN);
 }
 
 void CAN3_Callback(uint8_t instance, flexcan_event_type_t eventType, uint32_t buffIdx, flexcan_state_t *flexcanState)
 {
+    PROF_APP_BEGIN(PROF_SEC_ISR_CAN);
+
     struct_sfl_can_fifo_frame can_msg_receive;
     can_msg_receive.header.ptr_data = can_msg_receive.data;
 
@@ -331,17 +355,24 @@ void CAN3_Callback(uint8_t instance, flexcan_event_type_t eventType, uint32_t bu
 			{
         		// get received can msg, re-enable the FIFO receive interrupt
         		hal_can_receive(&can_handle, &can_msg_receive.header);
+        		// reception time for latency measurements
+        		can_rx_timestamp_us[instance] = time_app_now_us();
         		// Take over the data to db
         		sfl_can_db_rx_wrapper(instance, &can_msg_receive.header);
+        		// release the CAN input task of the main loop
+        		sched_app_event_post(SCHED_EVT_CAN_RX);
 			}
 			else
 			{
-				// do nothing
+				// the frame has been handed to the bootloader protocol, release its task
+				sched_app_event_post(SCHED_EVT_CAN_RX);
 			}
             break;
         default:
             break;
     }
+
+    PROF_APP_END(PROF_SEC_ISR_CAN);
 }
 
 void CAN_Callback_Error(uint8_t instance, flexcan_event_type_t eventType, flexcan_state_t *flexcanState)
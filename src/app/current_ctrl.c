@@ -0,0 +1,321 @@
+/*----------------------------------------------------------------------------*/
+/**
+ * \file         current_ctrl.c
+ * \brief        Current control of PWM outputs synchronised to the ADC frames
+ * \details      See current_ctrl.h
+ * \date         20261019
+ * \author       agent
+ *
+ */
+/*----------------------------------------------------------------------------*/
+#include "current_ctrl.h"
+#include "flexTimer1.h"
+#include "ftm_hw_access.h"
+#include "interrupt_manager.h"
+#include "hal_pwm.h"
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+typedef struct
+{
+    struct_current_ctrl_state_t state;
+    enum_adc_pin_name sense;
+    enum_pwm_pin_name pwm;
+    int32_t  kp;
+    int32_t  ki;
+    int32_t  out_min;                   // Q15
+    int32_t  out_max;                   // Q15
+    uint8_t  adc_instance;              // frame of the feedback input
+    uint8_t  frame_index;               // index of the feedback input in the frame values
+    uint8_t  ftm_module;
+    uint8_t  ftm_channel;
+} struct_current_ctrl_t;
+
+// ===================================================================================================
+// Global data definitions
+// ===================================================================================================
+static struct_current_ctrl_t mgl_current_ctrl[CURRENT_CTRL_CHN_MAX];
+static volatile uint8_t mgl_current_ctrl_cnt = 0u;                  // entries of mgl_current_ctrl in use
+static uint8_t mgl_current_ctrl_div[ADC_INSTANCE_COUNT];            // frames since the last loop step per ADC instance
+
+// ===================================================================================================
+// Internal function prototypes
+// ===================================================================================================
+static int32_t current_ctrl_step(struct_current_ctrl_t *ptr_cc);
+
+// ===================================================================================================
+// Functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* PI step in Q15. The integrator only takes over the new sum if the output isn't limited in the
+* direction of the error, and is kept inside the output range.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static int32_t current_ctrl_step(struct_current_ctrl_t *ptr_cc)
+{
+    struct_current_ctrl_state_t *ptr_st = &ptr_cc->state;
+    const int32_t err = (int32_t)ptr_st->setpoint - (int32_t)ptr_st->measured;
+    const int32_t p = (int32_t)(((int64_t)ptr_cc->kp * err) >> CURRENT_CTRL_Q);
+    int32_t integ = ptr_st->integ + (int32_t)(((int64_t)ptr_cc->ki * err) >> CURRENT_CTRL_Q);
+    int32_t out;
+
+    if (integ > ptr_cc->out_max)
+    {
+        integ = ptr_cc->out_max;
+    }
+    else if (integ < ptr_cc->out_min)
+    {
+        integ = ptr_cc->out_min;
+    }
+
+    out = p + integ;
+    ptr_st->limited = TRUE;
+    if (out > ptr_cc->out_max)
+    {
+        out = ptr_cc->out_max;
+        if (err <= 0)
+        {
+            ptr_st->integ = integ;
+        }
+    }
+    else if (out < ptr_cc->out_min)
+    {
+        out = ptr_cc->out_min;
+        if (err >= 0)
+        {
+            ptr_st->integ = integ;
+        }
+    }
+    else
+    {
+        ptr_st->integ = integ;
+        ptr_st->limited = FALSE;
+    }
+
+    return out;
+}
+
+// ===================================================================================================
+// Public functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The entry is complete before the count includes it, the interrupt skips it until it is enabled.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t current_ctrl_add(const struct_current_ctrl_cfg_t *ptr_cfg)
+{
+    uint8_t handle = CURRENT_CTRL_CHN_MAX;
+    uint8_t adc_instance = 0u;
+    uint8_t frame_index = 0u;
+
+    if ( (ptr_cfg != NULL) && (mgl_current_ctrl_cnt < CURRENT_CTRL_CHN_MAX) &&
+         (ptr_cfg->pwm < PWM_MAX) && (ptr_cfg->sense < ADC_MAX) &&
+         (adc_config_tbl[ptr_cfg->sense].multiplex == 0) &&
+         (ptr_cfg->duty_min <= ptr_cfg->duty_max) && (ptr_cfg->duty_max <= 1000u) &&
+         (adc_get_frame_index(ptr_cfg->sense, &adc_instance, &frame_index) == true) )
+    {
+        struct_current_ctrl_t *ptr_cc = &mgl_current_ctrl[mgl_current_ctrl_cnt];
+
+        ptr_cc->sense = ptr_cfg->sense;
+        ptr_cc->pwm = ptr_cfg->pwm;
+        ptr_cc->kp = ptr_cfg->kp;
+        ptr_cc->ki = ptr_cfg->ki;
+        ptr_cc->out_min = (int32_t)(((uint32_t)ptr_cfg->duty_min << CURRENT_CTRL_Q) / 1000u);
+        ptr_cc->out_max = (int32_t)(((uint32_t)ptr_cfg->duty_max << CURRENT_CTRL_Q) / 1000u);
+        ptr_cc->adc_instance = adc_instance;
+        ptr_cc->frame_index = frame_index;
+        ptr_cc->ftm_module = struct_ftm_config_tbl[ptr_cfg->pwm].pwm_instance;
+        ptr_cc->ftm_channel = struct_ftm_config_tbl[ptr_cfg->pwm].pwm_channel;
+        ptr_cc->state.setpoint = 0u;
+        ptr_cc->state.measured = 0u;
+        ptr_cc->state.duty = 0;
+        ptr_cc->state.integ = 0;
+        ptr_cc->state.limited = FALSE;
+        ptr_cc->state.enabled = FALSE;
+
+        // the compare values of a frame are taken over together at the next loading point
+        (void)hal_pwm_update_now(ptr_cfg->pwm, 0u);
+
+        handle = mgl_current_ctrl_cnt;
+        mgl_current_ctrl_cnt++;
+    }
+
+    return handle;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t current_ctrl_enable(uint8_t handle, uint8_t enable)
+{
+    uint8_t ret = FALSE;
+
+    if (handle < mgl_current_ctrl_cnt)
+    {
+        struct_current_ctrl_t *ptr_cc = &mgl_current_ctrl[handle];
+
+        INT_SYS_DisableIRQGlobal();
+        ptr_cc->state.enabled = (enable == TRUE) ? TRUE : FALSE;
+        ptr_cc->state.integ = 0;
+        ptr_cc->state.duty = 0;
+        INT_SYS_EnableIRQGlobal();
+
+        if (enable != TRUE)
+        {
+            (void)hal_pwm_set_duty(ptr_cc->pwm, 0u);
+        }
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t current_ctrl_set_setpoint(uint8_t handle, uint16_t setpoint)
+{
+    uint8_t ret = FALSE;
+
+    if (handle < mgl_current_ctrl_cnt)
+    {
+        mgl_current_ctrl[handle].state.setpoint = setpoint;
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t current_ctrl_set_gains(uint8_t handle, int32_t kp, int32_t ki)
+{
+    uint8_t ret = FALSE;
+
+    if (handle < mgl_current_ctrl_cnt)
+    {
+        INT_SYS_DisableIRQGlobal();
+        mgl_current_ctrl[handle].kp = kp;
+        mgl_current_ctrl[handle].ki = ki;
+        INT_SYS_EnableIRQGlobal();
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t current_ctrl_get_state(uint8_t handle, struct_current_ctrl_state_t *ptr_state)
+{
+    uint8_t ret = FALSE;
+
+    if ( (handle < mgl_current_ctrl_cnt) && (ptr_state != NULL) )
+    {
+        INT_SYS_DisableIRQGlobal();
+        *ptr_state = mgl_current_ctrl[handle].state;
+        INT_SYS_EnableIRQGlobal();
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* First all loops of the instance, then one software trigger per FTM module which got a new
+* compare value.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void current_ctrl_frame(uint8_t adc_instance, const adc_frame_value_t *ptr_values)
+{
+    uint8_t modules = 0u;
+
+    mgl_current_ctrl_div[adc_instance]++;
+    if (mgl_current_ctrl_div[adc_instance] >= CURRENT_CTRL_DIVIDER)
+    {
+        mgl_current_ctrl_div[adc_instance] = 0u;
+
+        for (uint8_t k = 0u; k < mgl_current_ctrl_cnt; k++)
+        {
+            struct_current_ctrl_t *ptr_cc = &mgl_current_ctrl[k];
+
+            if ( (ptr_cc->state.enabled == TRUE) && (ptr_cc->adc_instance == adc_instance) )
+            {
+                FTM_Type * const base = g_ftmBase[ptr_cc->ftm_module];
+                const uint32_t period = (uint32_t)FTM_DRV_GetMod(base) + 1u;
+
+                ptr_cc->state.measured = adc_get_cal_of_digit(ptr_cc->sense, (uint16_t)ptr_values[ptr_cc->frame_index]);
+
+                if (ptr_cc->state.setpoint == 0u)
+                {
+                    ptr_cc->state.integ = 0;
+                    ptr_cc->state.duty = 0;
+                    ptr_cc->state.limited = FALSE;
+                }
+                else
+                {
+                    ptr_cc->state.duty = current_ctrl_step(ptr_cc);
+                }
+
+                FTM_DRV_SetChnCountVal(base, ptr_cc->ftm_channel, (uint16_t)((period * (uint32_t)ptr_cc->state.duty) >> CURRENT_CTRL_Q));
+                modules |= (uint8_t)(1u << ptr_cc->ftm_module);
+            }
+        }
+
+        for (uint8_t m = 0u; (m < FTM_INSTANCE_COUNT) && (modules != 0u); m++)
+        {
+            if ((modules & (1u << m)) != 0u)
+            {
+                FTM_DRV_SetSoftwareTriggerCmd(g_ftmBase[m], true);
+                modules &= (uint8_t)~(1u << m);
+            }
+        }
+    }
+}
@@ -0,0 +1,132 @@
+#ifndef __CURRENT_CTRL_H_
+#define __CURRENT_CTRL_H_
+/*----------------------------------------------------------------------------*/
+/**
+* \file         current_ctrl.h
+* \brief        Current control of PWM outputs synchronised to the ADC frames
+* \details      Up to CURRENT_CTRL_CHN_MAX PI loops, each of them regulating the calibrated value of a not
+*               multiplexed analog input (e.g. AI_INA_OUT1, in mA) with the duty cycle of a PWM output.
+*               The loops run in the frame interrupt (or eDMA callback) of the ADC instance of their input,
+*               every CURRENT_CTRL_DIVIDER-th frame, so the loop timing doesn't depend on the main loop.
+*
+*               Fixed-point with 15 fractional bits (Q15) and no division per step:
+*               - duty cycle 0..CURRENT_CTRL_DUTY_ONE (32768 = 100 %)
+*               - gains in duty per unit of the error, e.g. kp = 33 is 0.1 % duty per mA
+*               - the integrator is limited to the duty range and stops while the output is limited in the
+*                 direction of the error (anti-windup)
+*
+*               All duty cycles computed in one frame are written to the compare registers first, then one
+*               software trigger per FTM module takes them over at the next loading point (the outputs are
+*               set to FTM_WAIT_LOADING_POINTS with hal_pwm_update_now when they are added).
+*
+*               Unlike user_pwm_current_control, which is still available, the loop uses the frame value
+*               instead of result_filtered. The output must not use the dither of user_pwm_set_dither.
+* \date         20261019
+* \author       agent
+*
+*/
+/*----------------------------------------------------------------------------*/
+
+#include "hal_data_types.h"
+#include "io_tables.h"
+#include "adc_app.h"
+
+
+// ===================================================================================================
+// Defines
+// ===================================================================================================
+#define CURRENT_CTRL_CHN_MAX        (8u)            ///< loops
+#define CURRENT_CTRL_Q              (15u)           ///< fractional bits of duty cycle and gains
+#define CURRENT_CTRL_DUTY_ONE       (1L << CURRENT_CTRL_Q)
+#ifndef CURRENT_CTRL_DIVIDER
+#define CURRENT_CTRL_DIVIDER        (1u)            ///< a loop step every n-th frame of the ADC instance
+#endif
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+typedef struct
+{
+    enum_pwm_pin_name pwm;              ///< output, struct_ftm_config_tbl
+    enum_adc_pin_name sense;            ///< feedback, not multiplexed
+    int32_t  kp;                        ///< proportional gain, Q15 duty per unit
+    int32_t  ki;                        ///< integral gain per loop step, Q15 duty per unit
+    uint16_t duty_min;                  ///< lower limit of the output in promille
+    uint16_t duty_max;                  ///< upper limit of the output in promille
+} struct_current_ctrl_cfg_t;
+
+typedef struct
+{
+    uint16_t setpoint;                  ///< unit of result_cal
+    uint16_t measured;                  ///< last calibrated feedback value
+    int32_t  duty;                      ///< last output, Q15
+    int32_t  integ;                     ///< integrator, Q15
+    uint8_t  limited;                   ///< TRUE if the last output was limited
+    uint8_t  enabled;
+} struct_current_ctrl_state_t;
+
+// ===================================================================================================
+// Public function prototypes
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Adds a loop, which starts disabled with setpoint 0.
+*
+* \param    ptr_cfg [in] const struct_current_ctrl_cfg_t*
+* \return   uint8_t                                         handle 0..CURRENT_CTRL_CHN_MAX - 1, CURRENT_CTRL_CHN_MAX if invalid or full
+*/
+uint8_t current_ctrl_add(const struct_current_ctrl_cfg_t *ptr_cfg);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Starts or stops a loop. A stopped loop sets the output to 0 and clears the integrator.
+*
+* \param    handle  [in] uint8_t
+* \param    enable  [in] uint8_t    TRUE / FALSE
+* \return   uint8_t                 FALSE if the handle is invalid
+*/
+uint8_t current_ctrl_enable(uint8_t handle, uint8_t enable);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Sets the setpoint, 0 switches the output off immediately like PI_Controller_Discrete.
+*
+* \param    handle      [in] uint8_t
+* \param    setpoint    [in] uint16_t   unit of result_cal of the feedback input
+* \return   uint8_t                     FALSE if the handle is invalid
+*/
+uint8_t current_ctrl_set_setpoint(uint8_t handle, uint16_t setpoint);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Changes the gains of a loop, the integrator is kept.
+*
+* \param    handle  [in] uint8_t
+* \param    kp      [in] int32_t    Q15 duty per unit
+* \param    ki      [in] int32_t    Q15 duty per unit and loop step
+* \return   uint8_t                 FALSE if the handle is invalid
+*/
+uint8_t current_ctrl_set_gains(uint8_t handle, int32_t kp, int32_t ki);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Copies the state of a loop.
+*
+* \param    handle      [in]  uint8_t
+* \param    ptr_state   [out] struct_current_ctrl_state_t*
+* \return   uint8_t                                         FALSE if the handle is invalid
+*/
+uint8_t current_ctrl_get_state(uint8_t handle, struct_current_ctrl_state_t *ptr_state);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Runs the loops of an ADC instance. Called by the frame interrupt / eDMA callback of adc_app.
+*
+* \param    adc_instance [in] uint8_t                   ADC instance of the frame
+* \param    ptr_values   [in] const adc_frame_value_t*  values of the frame, see adc_get_frame_index
+* \return   void
+*/
+void current_ctrl_frame(uint8_t adc_instance, const adc_frame_value_t *ptr_values);
+
+#endif
@@ -0,0 +1,345 @@
+/*----------------------------------------------------------------------------*/
+/**
+ * \file         debounce_app.c
+ * \brief        Debouncing of digital inputs in the 1 ms timer with an edge event queue
+ * \details      See debounce_app.h
+ * \date         20261019
+ * \author       agent
+ *
+ */
+/*----------------------------------------------------------------------------*/
+#include "debounce_app.h"
+#include "user_api_io.h"
+#include "hal_io.h"
+#include "time_app.h"
+#include "sfl_fifo.h"
+#include "interrupt_manager.h"
+
+#if (DEBOUNCE_APP_CNT_BITS < 1u) || (DEBOUNCE_APP_CNT_BITS > 16u)
+#error "debounce_app: DEBOUNCE_APP_CNT_BITS must be 1..16"
+#endif
+
+// ===================================================================================================
+// Global data definitions
+// ===================================================================================================
+static volatile uint8_t mgl_debounce_cnt = 0u;                          // inputs in use, lane k = input k
+static uint16_t mgl_debounce_pin[DEBOUNCE_APP_CHN_MAX];
+static uint8_t mgl_debounce_port[DEBOUNCE_APP_CHN_MAX];
+static uint8_t mgl_debounce_bit[DEBOUNCE_APP_CHN_MAX];
+static struct_io_port_set_t mgl_debounce_set;                           // ports and pins which are sampled
+
+static uint32_t mgl_debounce_state = 0u;                                // debounced states, bit k = input k
+static uint32_t mgl_debounce_counter[DEBOUNCE_APP_CNT_BITS];            // counter planes
+static uint32_t mgl_debounce_time[DEBOUNCE_APP_CNT_BITS];               // debounce time planes in ticks
+static uint64_t mgl_debounce_start[DEBOUNCE_APP_CHN_MAX];               // us, time_app_now_us of the first sample of a new level
+
+static struct_debounce_event_t mgl_debounce_queue[DEBOUNCE_APP_QUEUE_LEN];
+static SFL_FIFO_CONFIG_TYPE mgl_debounce_fifo;
+static uint32_t mgl_debounce_lost = 0u;
+
+// ===================================================================================================
+// Internal function prototypes
+// ===================================================================================================
+static uint8_t debounce_app_find(uint16_t pin);
+static void debounce_app_time_set(uint8_t lane, uint16_t debounce_ms);
+static uint32_t debounce_app_sample(void);
+
+// ===================================================================================================
+// Functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Returns the lane of a pin, DEBOUNCE_APP_CHN_MAX if it hasn't been added.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static uint8_t debounce_app_find(uint16_t pin)
+{
+    uint8_t lane = DEBOUNCE_APP_CHN_MAX;
+
+    for (uint8_t k = 0u; k < mgl_debounce_cnt; k++)
+    {
+        if (mgl_debounce_pin[k] == pin)
+        {
+            lane = k;
+            break;
+        }
+    }
+
+    return lane;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Writes the debounce time of a lane into the time planes. Called with disabled interrupts.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void debounce_app_time_set(uint8_t lane, uint16_t debounce_ms)
+{
+    uint32_t ticks = (uint32_t)debounce_ms / DEBOUNCE_APP_TICK_MS;
+
+    if (ticks < 1u)
+    {
+        ticks = 1u;
+    }
+    else if (ticks > DEBOUNCE_APP_TICKS_MAX)
+    {
+        ticks = DEBOUNCE_APP_TICKS_MAX;
+    }
+
+    for (uint8_t j = 0u; j < DEBOUNCE_APP_CNT_BITS; j++)
+    {
+        mgl_debounce_time[j] = (mgl_debounce_time[j] & ~(1uL << lane)) | (((ticks >> j) & 1uL) << lane);
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* One read per port, then the pins are picked into their lanes.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static uint32_t debounce_app_sample(void)
+{
+    struct_io_port_set_t port_state;
+    uint32_t sample = 0u;
+
+    user_di_port_read(&mgl_debounce_set, &port_state);
+
+    for (uint8_t k = 0u; k < mgl_debounce_cnt; k++)
+    {
+        sample |= ((port_state.mask[mgl_debounce_port[k]] >> mgl_debounce_bit[k]) & 1uL) << k;
+    }
+
+    return sample;
+}
+
+// ===================================================================================================
+// Public functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The lane is complete before the count includes it, so the timer doesn't see a half added input.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t debounce_app_add(uint16_t pin, uint16_t debounce_ms)
+{
+    uint8_t ret = FALSE;
+    uint8_t port = 0u;
+    uint8_t bit = 0u;
+    uint8_t level = 0u;
+
+    if ( (mgl_debounce_cnt < DEBOUNCE_APP_CHN_MAX) && (debounce_app_find(pin) == DEBOUNCE_APP_CHN_MAX) &&
+         (user_io_pin_port(pin, &port, &bit) == TRUE) )
+    {
+        const uint8_t lane = mgl_debounce_cnt;
+
+        if (lane == 0u)
+        {
+            (void)sfl_fifo_init(&mgl_debounce_fifo, DEBOUNCE_APP_QUEUE_LEN, sizeof(struct_debounce_event_t));
+        }
+
+        (void)hal_io_di_get(pin, &level);
+
+        mgl_debounce_pin[lane] = pin;
+        mgl_debounce_port[lane] = port;
+        mgl_debounce_bit[lane] = bit;
+
+        INT_SYS_DisableIRQGlobal();
+        debounce_app_time_set(lane, debounce_ms);
+        for (uint8_t j = 0u; j < DEBOUNCE_APP_CNT_BITS; j++)
+        {
+            mgl_debounce_counter[j] &= ~(1uL << lane);
+        }
+        mgl_debounce_state = (mgl_debounce_state & ~(1uL << lane)) | ((uint32_t)(level != 0u) << lane);
+        mgl_debounce_set.mask[port] |= 1uL << bit;
+        mgl_debounce_cnt = (uint8_t)(lane + 1u);
+        INT_SYS_EnableIRQGlobal();
+
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t debounce_app_set_time(uint16_t pin, uint16_t debounce_ms)
+{
+    uint8_t ret = FALSE;
+    const uint8_t lane = debounce_app_find(pin);
+
+    if (lane < DEBOUNCE_APP_CHN_MAX)
+    {
+        INT_SYS_DisableIRQGlobal();
+        debounce_app_time_set(lane, debounce_ms);
+        INT_SYS_EnableIRQGlobal();
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t debounce_app_get(uint16_t pin)
+{
+    uint8_t state = 0u;
+    const uint8_t lane = debounce_app_find(pin);
+
+    if (lane < DEBOUNCE_APP_CHN_MAX)
+    {
+        state = (uint8_t)((mgl_debounce_state >> lane) & 1uL);
+    }
+
+    return state;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The timer puts events while the main loop takes them, the fifo counter isn't changed atomically.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t debounce_app_event_get(struct_debounce_event_t *ptr_event)
+{
+    uint8_t ret = FALSE;
+
+    if ( (ptr_event != NULL) && (mgl_debounce_cnt > 0u) )
+    {
+        INT_SYS_DisableIRQGlobal();
+        if (sfl_fifo_get(&mgl_debounce_fifo, (uint8_t*)ptr_event, (uint8_t*)mgl_debounce_queue) == SFL_FIFO_ERROR_NONE)
+        {
+            ret = TRUE;
+        }
+        INT_SYS_EnableIRQGlobal();
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint32_t debounce_app_event_lost(void)
+{
+    return mgl_debounce_lost;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* delta are the inputs whose sample differs from the debounced state. Their counters are incremented
+* (ripple carry through the planes), all others are cleared. An input whose counter is equal to its
+* debounce time toggles its state, its counter is cleared and the event is queued.
+* A counter which starts (was 0) stores the timestamp of its first sample.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void debounce_app_tick(void)
+{
+    const uint8_t cnt = mgl_debounce_cnt;
+
+    if (cnt > 0u)
+    {
+        const uint32_t delta = debounce_app_sample() ^ mgl_debounce_state;
+        uint32_t running = 0u;
+        uint32_t carry = delta;
+        uint32_t done = delta;
+        uint32_t start;
+        uint64_t now = 0u;
+
+        for (uint8_t j = 0u; j < DEBOUNCE_APP_CNT_BITS; j++)
+        {
+            const uint32_t c = mgl_debounce_counter[j] & delta;
+
+            running |= mgl_debounce_counter[j];
+            mgl_debounce_counter[j] = c ^ carry;
+            carry &= c;
+            done &= ~(mgl_debounce_counter[j] ^ mgl_debounce_time[j]);
+        }
+        start = delta & ~running;
+
+        if ((start | done) != 0u)
+        {
+            now = time_app_now_us();
+        }
+
+        for (uint8_t k = 0u; (k < cnt) && ((start | done) != 0u); k++)
+        {
+            const uint32_t lane = 1uL << k;
+
+            if ((start & lane) != 0u)
+            {
+                mgl_debounce_start[k] = now;
+                start &= ~lane;
+            }
+            if ((done & lane) != 0u)
+            {
+                struct_debounce_event_t event;
+
+                mgl_debounce_state ^= lane;
+                for (uint8_t j = 0u; j < DEBOUNCE_APP_CNT_BITS; j++)
+                {
+                    mgl_debounce_counter[j] &= ~lane;
+                }
+
+                event.timestamp_us = mgl_debounce_start[k];
+                event.pin = mgl_debounce_pin[k];
+                event.level = (uint8_t)((mgl_debounce_state & lane) != 0u);
+                if (sfl_fifo_put(&mgl_debounce_fifo, (uint8_t*)&event, (uint8_t*)mgl_debounce_queue) != SFL_FIFO_ERROR_NONE)
+                {
+                    mgl_debounce_lost++;
+                }
+                done &= ~lane;
+            }
+        }
+    }
+}
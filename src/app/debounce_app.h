@@ -0,0 +1,111 @@
+#ifndef __DEBOUNCE_APP_H_
+#define __DEBOUNCE_APP_H_
+/*----------------------------------------------------------------------------*/
+/**
+* \file         debounce_app.h
+* \brief        Debouncing of digital inputs in the 1 ms timer with an edge event queue
+* \details      Up to DEBOUNCE_APP_CHN_MAX GPIO inputs are sampled every DEBOUNCE_APP_TICK_MS with one port
+*               read per port (user_di_port_read), independent of the main loop. A pulse longer than the
+*               debounce time of its input is recognised even if it is shorter than a main loop cycle.
+*
+*               Debouncing with vertical counters: bit k of the counter planes is the counter of input k,
+*               so all inputs are counted with a few bitwise operations per tick. The counter of an input
+*               runs while the sample differs from the debounced state and is cleared as soon as it is the
+*               same again. The new state is taken over when the counter reaches the debounce time of the
+*               input (in ticks, also kept as bit planes), 1..DEBOUNCE_APP_TICKS_MAX.
+*
+*               Each change of a debounced state is put into the event queue with its input, the new level
+*               and the 64 bit us timestamp (time_app) of the first sample of the new level. usercode() takes
+*               the events with debounce_app_event_get. If the queue is full, the event is lost and counted.
+* \date         20261019
+* \author       agent
+*
+*/
+/*----------------------------------------------------------------------------*/
+
+#include "hal_data_types.h"
+#include "io_tables.h"
+
+
+// ===================================================================================================
+// Defines
+// ===================================================================================================
+#define DEBOUNCE_APP_CHN_MAX        (32u)                                   ///< inputs, one bit of the planes each
+#define DEBOUNCE_APP_TICK_MS        (1u)                                    ///< sample period, 1 ms timer
+#ifndef DEBOUNCE_APP_CNT_BITS
+#define DEBOUNCE_APP_CNT_BITS       (8u)                                    ///< counter planes
+#endif
+#define DEBOUNCE_APP_TICKS_MAX      ((1uL << DEBOUNCE_APP_CNT_BITS) - 1u)   ///< longest debounce time in ticks
+#ifndef DEBOUNCE_APP_QUEUE_LEN
+#define DEBOUNCE_APP_QUEUE_LEN      (32u)                                   ///< events
+#endif
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+typedef struct
+{
+    uint64_t timestamp_us;              ///< time_app_now_us of the first sample of the new level
+    uint16_t pin;                       ///< Ports & Interfaces: pin
+    uint8_t  level;                     ///< new debounced state
+} struct_debounce_event_t;
+
+// ===================================================================================================
+// Public function prototypes
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Adds an input, its debounced state starts with the current pin state.
+*
+* \param    pin         [in] uint16_t   Ports & Interfaces: digital input pin, configured as GPIO
+* \param    debounce_ms [in] uint16_t   debounce time, rounded to ticks and limited to 1..DEBOUNCE_APP_TICKS_MAX
+* \return   uint8_t                     FALSE if the pin isn't a GPIO pin, already added or no input is left
+*/
+uint8_t debounce_app_add(uint16_t pin, uint16_t debounce_ms);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Changes the debounce time of an input.
+*
+* \param    pin         [in] uint16_t
+* \param    debounce_ms [in] uint16_t
+* \return   uint8_t                     FALSE if the pin hasn't been added
+*/
+uint8_t debounce_app_set_time(uint16_t pin, uint16_t debounce_ms);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Returns the debounced state of an input, 0 if the pin hasn't been added.
+*
+* \param    pin [in] uint16_t
+* \return   uint8_t
+*/
+uint8_t debounce_app_get(uint16_t pin);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Takes the oldest event from the queue.
+*
+* \param    ptr_event [out] struct_debounce_event_t*
+* \return   uint8_t                                 FALSE if the queue is empty
+*/
+uint8_t debounce_app_event_get(struct_debounce_event_t *ptr_event);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Returns the number of events lost because the queue was full.
+*
+* \return   uint32_t
+*/
+uint32_t debounce_app_event_lost(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Samples and debounces all inputs. Called by the 1 ms timer interrupt.
+*
+* \return   void
+*/
+void debounce_app_tick(void);
+
+#endif
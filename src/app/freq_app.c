@@ -0,0 +1,354 @@
+/*----------------------------------------------------------------------------*/
+/**
+ * \file         freq_app.c
+ * \brief        Frequency and duty cycle measurement of the FREQ inputs with eDMA input capture
+ * \details      See freq_app.h
+ * \date         20261019
+ * \author       agent
+ *
+ */
+/*----------------------------------------------------------------------------*/
+#include "freq_app.h"
+#include "flexTimer1.h"
+#include "ftm_hw_access.h"
+#include "edma_driver.h"
+#include "edma_hw_access.h"
+#include "interrupt_manager.h"
+#include "sfl_timer.h"
+
+#if ((FREQ_APP_RING_LEN & (FREQ_APP_RING_LEN - 1u)) != 0u)
+#error "freq_app: FREQ_APP_RING_LEN must be a power of 2"
+#endif
+
+#define FREQ_APP_RING_MARGIN        (8u)                // newest entries which aren't overwritten while freq_app_get reads the ring
+#define FREQ_APP_EDGE_BOTH          (3u)                // ELSB:ELSA, capture on rising and falling edges
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+typedef struct
+{
+    struct_freq_app_cfg_t cfg;
+    FTM_Type *base;
+    uint8_t  ftm_instance;
+    uint8_t  ftm_channel;
+    uint8_t  dma_channel;
+    uint8_t  rising_parity;             // ring index parity of the rising edges
+    uint32_t edge_first;                // oldest usable edge, its polarity follows from rising_parity
+    uint32_t edges_last;                // edges at the last freq_app_get
+    uint32_t edge_ts;                   // timestamp in ms when edges_last changed
+} struct_freq_app_chn_t;
+
+// ===================================================================================================
+// Global data definitions
+// ===================================================================================================
+static struct_freq_app_chn_t mgl_freq_chn[FREQ_APP_CHN_MAX];
+static uint8_t mgl_freq_cnt = 0u;
+static uint16_t mgl_freq_ring[FREQ_APP_CHN_MAX][FREQ_APP_RING_LEN];     // capture values, written by the eDMA
+static volatile uint32_t mgl_freq_wraps[FREQ_APP_CHN_MAX];              // completed ring cycles
+static edma_chn_state_t mgl_freq_dma_state[FREQ_APP_CHN_MAX];
+
+// ===================================================================================================
+// Internal function prototypes
+// ===================================================================================================
+void freq_app_dma_done(void *parameter, edma_chn_status_t status);
+static uint32_t freq_app_edges(const struct_freq_app_chn_t *ptr_chn, uint8_t handle);
+static uint8_t freq_app_sync(struct_freq_app_chn_t *ptr_chn);
+
+// ===================================================================================================
+// Functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* eDMA major loop callback, once per FREQ_APP_RING_LEN edges.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void freq_app_dma_done(void *parameter, edma_chn_status_t status)
+{
+    const uint8_t handle = (uint8_t)(uint32_t)parameter;
+
+    if (status == EDMA_CHN_NORMAL)
+    {
+        mgl_freq_wraps[handle]++;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Edges since the start: completed ring cycles and the position of the eDMA in the ring, read with the
+* interrupts locked. When the major loop has completed, CITER starts again at FREQ_APP_RING_LEN before
+* freq_app_dma_done has counted the cycle: the cycle is added while the interrupt flag of the channel
+* is pending. If the flag is set between the two reads of it, CITER is read again after the reload.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static uint32_t freq_app_edges(const struct_freq_app_chn_t *ptr_chn, uint8_t handle)
+{
+    const uint32_t int_mask = 1uL << ptr_chn->dma_channel;
+    uint32_t wraps;
+    uint32_t remaining;
+    uint32_t pending;
+
+    INT_SYS_DisableIRQGlobal();
+    pending = DMA->INT & int_mask;
+    remaining = EDMA_DRV_GetRemainingMajorIterationsCount(ptr_chn->dma_channel);
+    if ( (pending == 0u) && ((DMA->INT & int_mask) != 0u) )
+    {
+        pending = int_mask;
+        remaining = EDMA_DRV_GetRemainingMajorIterationsCount(ptr_chn->dma_channel);
+    }
+    wraps = mgl_freq_wraps[handle] + ((pending != 0u) ? 1u : 0u);
+    INT_SYS_EnableIRQGlobal();
+
+    return (wraps * FREQ_APP_RING_LEN) + (FREQ_APP_RING_LEN - remaining);
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Reads the input state for the assignment of the edges which follow. If an edge is captured while
+* the state is read, it is read again, so the state is the one before the next captured edge.
+* Returns the input state.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static uint8_t freq_app_sync(struct_freq_app_chn_t *ptr_chn)
+{
+    const uint8_t handle = (uint8_t)(ptr_chn - mgl_freq_chn);
+    uint32_t edges;
+    uint8_t level;
+
+    do
+    {
+        edges = freq_app_edges(ptr_chn, handle);
+        level = (uint8_t)((ptr_chn->base->CONTROLS[ptr_chn->ftm_channel].CnSC & FTM_CnSC_CHIS_MASK) != 0u);
+    } while (edges != freq_app_edges(ptr_chn, handle));
+
+    // high: the next edge is a falling one
+    ptr_chn->edge_first = edges;
+    ptr_chn->rising_parity = (uint8_t)((edges + level) & 1u);
+
+    return level;
+}
+
+// ===================================================================================================
+// Public functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The eDMA copies CnV to the ring on every capture request, major loop = one ring cycle with the
+* destination moved back to the start and the request kept enabled. The channel is switched to
+* both edges and to eDMA requests, after the eDMA channel is running.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t freq_app_start(const struct_freq_app_cfg_t *ptr_cfg)
+{
+    uint8_t handle = FREQ_APP_CHN_MAX;
+
+    if ( (ptr_cfg != NULL) && (mgl_freq_cnt < FREQ_APP_CHN_MAX) &&
+         (ptr_cfg->pin > PWM_MAX) && (ptr_cfg->pin < FREQ_MAX) &&
+         (ptr_cfg->periods >= 1u) && (ptr_cfg->periods <= FREQ_APP_PERIODS_MAX) &&
+         ( (struct_ftm_config_tbl[ptr_cfg->pin].pwm_instance == 1) || (struct_ftm_config_tbl[ptr_cfg->pin].pwm_instance == 2) ) )
+    {
+        struct_freq_app_chn_t *ptr_chn = &mgl_freq_chn[mgl_freq_cnt];
+        edma_loop_transfer_config_t loop_config = {0};
+        edma_transfer_config_t transfer_config = {0};
+        edma_channel_config_t channel_config = {0};
+        const dma_request_source_t request_first = (struct_ftm_config_tbl[ptr_cfg->pin].pwm_instance == 1) ?
+                                                   EDMA_REQ_FTM1_CHANNEL_0 : EDMA_REQ_FTM2_CHANNEL_0;
+
+        handle = mgl_freq_cnt;
+        ptr_chn->cfg = *ptr_cfg;
+        ptr_chn->ftm_instance = (uint8_t)struct_ftm_config_tbl[ptr_cfg->pin].pwm_instance;
+        ptr_chn->ftm_channel = (uint8_t)struct_ftm_config_tbl[ptr_cfg->pin].pwm_channel;
+        ptr_chn->base = g_ftmBase[ptr_chn->ftm_instance];
+        ptr_chn->dma_channel = (uint8_t)(FREQ_APP_DMA_CHN_FIRST + handle);
+        mgl_freq_wraps[handle] = 0u;
+
+        channel_config.channelPriority = EDMA_CHN_DEFAULT_PRIORITY;
+        channel_config.virtChnConfig = ptr_chn->dma_channel;
+        channel_config.source = (dma_request_source_t)((uint32_t)request_first + ptr_chn->ftm_channel);
+        channel_config.callback = &freq_app_dma_done;
+        channel_config.callbackParam = (void*)(uint32_t)handle;
+        channel_config.enableTrigger = false;
+        (void)EDMA_DRV_ChannelInit(&mgl_freq_dma_state[handle], &channel_config);
+
+        // one request = one capture value
+        loop_config.majorLoopIterationCount = FREQ_APP_RING_LEN;
+        transfer_config.srcAddr = (uint32_t)&ptr_chn->base->CONTROLS[ptr_chn->ftm_channel].CnV;
+        transfer_config.destAddr = (uint32_t)mgl_freq_ring[handle];
+        transfer_config.srcTransferSize = EDMA_TRANSFER_SIZE_2B;
+        transfer_config.destTransferSize = EDMA_TRANSFER_SIZE_2B;
+        transfer_config.srcOffset = 0;
+        transfer_config.destOffset = 2;
+        transfer_config.srcLastAddrAdjust = 0;
+        transfer_config.destLastAddrAdjust = -(int32_t)(FREQ_APP_RING_LEN * 2u);
+        transfer_config.srcModulo = EDMA_MODULO_OFF;
+        transfer_config.destModulo = EDMA_MODULO_OFF;
+        transfer_config.minorByteTransferCount = 2u;
+        transfer_config.scatterGatherEnable = false;
+        transfer_config.interruptEnable = true;
+        transfer_config.loopTransferConfig = &loop_config;
+        EDMA_DRV_PushConfigToReg(ptr_chn->dma_channel, &transfer_config);
+        EDMA_TCDSetDisableDmaRequestAfterTCDDoneCmd(DMA, ptr_chn->dma_channel, false);
+        (void)EDMA_DRV_StartChannel(ptr_chn->dma_channel);
+
+        INT_SYS_DisableIRQGlobal();
+        FTM_DRV_SetChnDmaCmd(ptr_chn->base, ptr_chn->ftm_channel, false);
+        FTM_DRV_SetChnEdgeLevel(ptr_chn->base, ptr_chn->ftm_channel, FREQ_APP_EDGE_BOTH);
+        FTM_DRV_ClearChnEventFlag(ptr_chn->base, ptr_chn->ftm_channel);
+        (void)freq_app_sync(ptr_chn);
+        FTM_DRV_EnableChnInt(ptr_chn->base, ptr_chn->ftm_channel);
+        FTM_DRV_SetChnDmaCmd(ptr_chn->base, ptr_chn->ftm_channel, true);
+        INT_SYS_EnableIRQGlobal();
+
+        ptr_chn->edges_last = 0u;
+        (void)sfl_timer_set_timestamp(&ptr_chn->edge_ts, HAL_PRECISION_1MS);
+
+        mgl_freq_cnt++;
+    }
+
+    return handle;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t freq_app_set_window(uint8_t handle, uint8_t periods, uint32_t window_us)
+{
+    uint8_t ret = FALSE;
+
+    if ( (handle < mgl_freq_cnt) && (periods >= 1u) && (periods <= FREQ_APP_PERIODS_MAX) )
+    {
+        mgl_freq_chn[handle].cfg.periods = periods;
+        mgl_freq_chn[handle].cfg.window_us = window_us;
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Walks back from the newest rising edge, one period (rising - rising) and its high time
+* (falling - rising) per step. The differences are taken modulo the FTM counter cycle. Only edges
+* after the last synchronisation and at least FREQ_APP_RING_MARGIN behind the eDMA are used.
+*
+* The edge count wraps after 2^32 edges (about 30 h at 20 kHz), so the edges are compared as offsets
+* from edge_first, which follows the oldest usable edge. The ring index and the parity of an edge
+* are the same modulo 2^32, since FREQ_APP_RING_LEN is a power of 2.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t freq_app_get(uint8_t handle, struct_freq_app_result_t *ptr_result)
+{
+    uint8_t ret = FALSE;
+
+    if ( (handle < mgl_freq_cnt) && (ptr_result != NULL) )
+    {
+        struct_freq_app_chn_t *ptr_chn = &mgl_freq_chn[handle];
+        const uint16_t *ptr_ring = mgl_freq_ring[handle];
+        const uint32_t edges = freq_app_edges(ptr_chn, handle);
+        const uint32_t now = sfl_timer_now_ms();
+
+        ptr_result->freq_mhz = 0u;
+        ptr_result->period_ns = 0u;
+        ptr_result->duty = 0u;
+        ptr_result->periods = 0u;
+        ptr_result->edges = edges;
+
+        if (edges != ptr_chn->edges_last)
+        {
+            ptr_chn->edges_last = edges;
+            ptr_chn->edge_ts = now;
+        }
+
+        if ( (ptr_chn->cfg.timeout_ms > 0u) && ((now - ptr_chn->edge_ts) >= ptr_chn->cfg.timeout_ms) )
+        {
+            // no edge: static input, the next edges are assigned by the input state
+            ptr_result->duty = (freq_app_sync(ptr_chn) != 0u) ? 1000u : 0u;
+        }
+        else if ((uint32_t)(edges - ptr_chn->edge_first) > 0u)
+        {
+            const uint32_t cycle = (uint32_t)FTM_DRV_GetMod(ptr_chn->base) + 1u;
+            const uint32_t ftm_hz = FTM_DRV_GetFrequency(ptr_chn->ftm_instance);
+            const uint64_t window = ((uint64_t)ptr_chn->cfg.window_us * ftm_hz) / 1000000u;
+            uint32_t avail = edges - ptr_chn->edge_first;    // edges since the oldest usable one
+            uint32_t r = avail - 1u;                            // offset of the newest edge from edge_first
+            uint32_t sum = 0u;
+            uint32_t high = 0u;
+            uint16_t n = 0u;
+
+            if (avail > (FREQ_APP_RING_LEN - FREQ_APP_RING_MARGIN))
+            {
+                // the older entries are overwritten, they are never used again
+                ptr_chn->edge_first = edges - (FREQ_APP_RING_LEN - FREQ_APP_RING_MARGIN);
+                avail = FREQ_APP_RING_LEN - FREQ_APP_RING_MARGIN;
+                r = avail - 1u;
+            }
+            if ( (((ptr_chn->edge_first + r) & 1u) != ptr_chn->rising_parity) && (r > 0u) )
+            {
+                r--;
+            }
+
+            while ( (n < ptr_chn->cfg.periods) && (r >= 2u) )
+            {
+                const uint32_t idx = ptr_chn->edge_first + r;
+                const uint32_t t_rise = ptr_ring[idx & (FREQ_APP_RING_LEN - 1u)];
+                const uint32_t t_fall = ptr_ring[(idx - 1u) & (FREQ_APP_RING_LEN - 1u)];
+                const uint32_t t_prev = ptr_ring[(idx - 2u) & (FREQ_APP_RING_LEN - 1u)];
+
+                sum += (t_rise >= t_prev) ? (t_rise - t_prev) : (t_rise + cycle - t_prev);
+                high += (t_fall >= t_prev) ? (t_fall - t_prev) : (t_fall + cycle - t_prev);
+                n++;
+                r -= 2u;
+
+                if ( (window != 0u) && (sum >= window) )
+                {
+                    break;
+                }
+            }
+
+            if ( (n > 0u) && (sum > 0u) && (ftm_hz > 0u) )
+            {
+                ptr_result->freq_mhz = (uint32_t)(((uint64_t)n * ftm_hz * 1000u) / sum);
+                ptr_result->period_ns = (uint32_t)(((uint64_t)sum * 1000000000u) / ((uint64_t)n * ftm_hz));
+                ptr_result->duty = (uint16_t)(((uint64_t)high * 1000u) / sum);
+                ptr_result->periods = n;
+            }
+        }
+
+        ret = TRUE;
+    }
+
+    return ret;
+}
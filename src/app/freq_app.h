@@ -0,0 +1,99 @@
+#ifndef __FREQ_APP_H_
+#define __FREQ_APP_H_
+/*----------------------------------------------------------------------------*/
+/**
+* \file         freq_app.h
+* \brief        Frequency and duty cycle measurement of the FREQ inputs with eDMA input capture
+* \details      The FTM channel of a frequency input captures both edges. Instead of an interrupt per edge,
+*               each capture requests the eDMA, which copies the 16 bit capture value into a ring of
+*               FREQ_APP_RING_LEN entries. The eDMA interrupts once per ring cycle to count the edges.
+*
+*               freq_app_get evaluates the newest entries of the ring: up to the configured number of
+*               periods, ending early once the periods span the configured window. Frequency, duty cycle and
+*               period are the averages over these periods, so the reading is smoothed and the CPU time only
+*               depends on the number of periods, not on the input frequency.
+*
+*               Rising and falling edges are told apart by their position in the ring, the input state
+*               is read once when the measurement (re)starts. Without an edge for timeout_ms the frequency
+*               is 0, the duty cycle shows the input state and the edge assignment restarts.
+*
+*               Limits:
+*               - a period must be shorter than the FTM counter cycle (MOD + 1 ticks, see
+*                 hal_freq_config_freq_measurment for the prescaler), longer periods are aliased
+*               - only inputs on FTM1 and FTM2 (eDMA request per channel)
+*               - while a channel is measured here, hal_freq_get_freq / user_freq_get_measured_freq of that
+*                 input aren't updated any more
+* \date         20261019
+* \author       agent
+*
+*/
+/*----------------------------------------------------------------------------*/
+
+#include "hal_data_types.h"
+#include "io_tables.h"
+
+
+// ===================================================================================================
+// Defines
+// ===================================================================================================
+#define FREQ_APP_CHN_MAX            (4u)                            ///< inputs measured with eDMA
+#define FREQ_APP_DMA_CHN_FIRST      (5u)                            ///< eDMA channels FREQ_APP_DMA_CHN_FIRST.. (1, 2: SCI, 3, 4: ADC)
+#define FREQ_APP_RING_LEN           (128u)                          ///< capture values per input, power of 2
+#define FREQ_APP_PERIODS_MAX        ((FREQ_APP_RING_LEN / 2u) - 4u) ///< periods which can be averaged
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+typedef struct
+{
+    uint16_t pin;                       ///< FREQ_IN.. of struct_ftm_config_tbl
+    uint8_t  periods;                   ///< periods averaged, 1..FREQ_APP_PERIODS_MAX
+    uint32_t window_us;                 ///< stop averaging once the periods span this time, 0 = periods only
+    uint16_t timeout_ms;                ///< no edge for this time: 0 Hz
+} struct_freq_app_cfg_t;
+
+typedef struct
+{
+    uint32_t freq_mhz;                  ///< averaged frequency in mHz
+    uint32_t period_ns;                 ///< averaged period in ns
+    uint16_t duty;                      ///< averaged duty cycle 0 - 1000 (0 - 100%)
+    uint16_t periods;                   ///< number of periods averaged, 0 = no valid period
+    uint32_t edges;                     ///< edges since the start of the measurement, modulo 2^32
+} struct_freq_app_result_t;
+
+// ===================================================================================================
+// Public function prototypes
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Starts the eDMA measurement of a frequency input.
+* \details  Called after hal_freq_init, which configures the FTM channel as input capture.
+*
+* \param    ptr_cfg [in] const struct_freq_app_cfg_t*
+* \return   uint8_t                                     handle 0..FREQ_APP_CHN_MAX - 1, FREQ_APP_CHN_MAX if invalid or full
+*/
+uint8_t freq_app_start(const struct_freq_app_cfg_t *ptr_cfg);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Changes the averaging of an input.
+*
+* \param    handle      [in] uint8_t
+* \param    periods     [in] uint8_t    1..FREQ_APP_PERIODS_MAX
+* \param    window_us   [in] uint32_t   0 = periods only
+* \return   uint8_t                     FALSE if the handle or periods is invalid
+*/
+uint8_t freq_app_set_window(uint8_t handle, uint8_t periods, uint32_t window_us);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Evaluates the newest periods of an input. Called in the main loop (not in an interrupt).
+*
+* \param    handle      [in]  uint8_t
+* \param    ptr_result  [out] struct_freq_app_result_t*
+* \return   uint8_t                                     FALSE if the handle is invalid
+*/
+uint8_t freq_app_get(uint8_t handle, struct_freq_app_result_t *ptr_result);
+
+#endif
@@ -1,11 +1,130 @@
 #include "ftm_app.h"
+#include "prof_app.h"
 #include "pins_port_hw_access.h"
+#include "ftm_hw_access.h"
+#include "interrupt_manager.h"
 #include "hal_pwm.h"
+#include "adc_capture.h"
 
 
 /* Global array with values needed to handle the PWM dither feature */
 struct_pwm_vals_def pwm_vals_t[PWM_MAX + 1];
 
+/* Pins with active dither per FTM module, maintained by ftm_dither_update */
+static uint8_t mgl_ftm_dither_pin[FTM_INSTANCE_COUNT][PWM_MAX];
+static uint8_t mgl_ftm_dither_cnt[FTM_INSTANCE_COUNT];
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Compare value of a duty in promille, limited to 0..mod + 1 (100 %) like the range check of
+* hal_pwm_set_duty, since the value is written to CnV directly.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static uint16_t ftm_dither_cnv(int32_t period, int32_t promille)
+{
+	int32_t cnv = (period * promille) / 1000;
+
+	if (cnv < 0)
+	{
+		cnv = 0;
+	}
+	else if (cnv > period)
+	{
+		cnv = period;
+	}
+	else
+	{
+		// in range
+	}
+
+	return (cnv > 0xFFFF) ? 0xFFFFu : (uint16_t)cnv;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Compare values of duty +/- dither for the modulo of the module. Edge aligned PWM like
+* hal_pwm_set_duty, 1000 promille is mod + 1 (100 %).
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void ftm_dither_prepare(uint8_t pin, uint16_t mod)
+{
+	struct_pwm_vals_def *ptr = &pwm_vals_t[pin];
+	const int32_t period = (int32_t)mod + 1;
+
+	ptr->cnv_high = ftm_dither_cnv(period, (int32_t)ptr->pwm_promille_backup + (int32_t)ptr->dither_promille);
+	ptr->cnv_low = ftm_dither_cnv(period, (int32_t)ptr->pwm_promille_backup - (int32_t)ptr->dither_promille);
+	ptr->cnv_mod = mod;
+	ptr->dither_half = (uint16_t)((ptr->dither_counts + 1u) / 2u);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The list is changed with the interrupts disabled, so the overflow handler never sees a pin twice
+* or a half removed entry.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void ftm_dither_update(uint8_t pin)
+{
+	if (pin < PWM_MAX)
+	{
+		const uint8_t module = struct_ftm_config_tbl[pin].pwm_instance;
+		uint8_t *list = mgl_ftm_dither_pin[module];
+		uint8_t idx = mgl_ftm_dither_cnt[module];
+
+		INT_SYS_DisableIRQGlobal();
+
+		for (uint8_t k = 0; k < mgl_ftm_dither_cnt[module]; k++)
+		{
+			if (list[k] == pin)
+			{
+				idx = k;
+			}
+		}
+
+		if (pwm_vals_t[pin].dither_promille != 0u)
+		{
+			ftm_dither_prepare(pin, FTM_DRV_GetMod(g_ftmBase[module]));
+			if (idx == mgl_ftm_dither_cnt[module])
+			{
+				// new entry, starts with the positive half
+				pwm_vals_t[pin].dither_counter = 0u;
+				pwm_vals_t[pin].dither_stat = 1;
+				list[idx] = pin;
+				mgl_ftm_dither_cnt[module]++;
+			}
+		}
+		else if (idx < mgl_ftm_dither_cnt[module])
+		{
+			// the last entry takes the place of the removed one
+			mgl_ftm_dither_cnt[module]--;
+			list[idx] = list[mgl_ftm_dither_cnt[module]];
+		}
+		else
+		{
+			// do nothing
+		}
+
+		INT_SYS_EnableIRQGlobal();
+	}
+}
+
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -65,42 +184,49 @@ uint32_t change_pin_to_adc(enum_pin_name pin)
 */
 void FTM_IRQHandler(uint8_t module)
 {
-	uint8_t i;
+	PROF_APP_BEGIN(PROF_SEC_ISR_FTM);
+
+	FTM_Type * const base = g_ftmBase[module];
+	const uint16_t mod = FTM_DRV_GetMod(base);
+	uint8_t written = 0;
 
-	for (i = 0; i < PWM_MAX; i++)
+	// period start of the module, trigger of the waveform capture
+	adc_capture_pwm_edge(module);
+
+	// Update only the dither of the pins of the FTM module which triggered the interrupt
+	for (uint8_t k = 0; k < mgl_ftm_dither_cnt[module]; k++)
 	{
-		if (struct_ftm_config_tbl[i].pwm_instance == module)	// Update only the dither of the pins of the FTM module which triggered the interrupt
+		const uint8_t i = mgl_ftm_dither_pin[module][k];
+		struct_pwm_vals_def *ptr = &pwm_vals_t[i];
+
+		// the frequency has been changed after user_pwm_set_dither
+		if (ptr->cnv_mod != mod)
 		{
-			if (pwm_vals_t[i].dither_promille)
-			{
-				// If dither is active
-				pwm_vals_t[i].dither_counter++;
-
-				// Invert the dither after half the PWM period
-				if (pwm_vals_t[i].dither_counter >= (pwm_vals_t[i].dither_counts + 1) / 2)
-				{
-					pwm_vals_t[i].dither_counter = 0;
-
-					pwm_vals_t[i].dither_stat = ~pwm_vals_t[i].dither_stat + 1; // invert  1 will become -1 and -1 will become 1
-
-					// Set new duty cycle
-					hal_pwm_set_duty(i, (uint16_t)((pwm_vals_t[i].pwm_promille_backup + pwm_vals_t[i].dither_stat * pwm_vals_t[i].dither_promille)));
-				}
-				else
-				{
-					// do nothing
-				}
-			}
-			else
-			{
-				// do nothing
-			}
+			ftm_dither_prepare(i, mod);
 		}
-		else
+
+		ptr->dither_counter++;
+
+		// Invert the dither after half the PWM period
+		if (ptr->dither_counter >= ptr->dither_half)
 		{
-			// do nothing
+			ptr->dither_counter = 0;
+
+			ptr->dither_stat = ~ptr->dither_stat + 1; // invert  1 will become -1 and -1 will become 1
+
+			// Set new duty cycle
+			FTM_DRV_SetChnCountVal(base, struct_ftm_config_tbl[i].pwm_channel, (ptr->dither_stat > 0) ? ptr->cnv_high : ptr->cnv_low);
+			written = 1;
 		}
 	}
+
+	// take over the new compare values with the next loading point
+	if (written)
+	{
+		FTM_DRV_SetSoftwareTriggerCmd(base, true);
+	}
+
+	PROF_APP_END(PROF_SEC_ISR_FTM);
 }
 
 
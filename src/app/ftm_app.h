@@ -21,6 +21,10 @@ typedef struct {
   int8_t  	dither_stat;			// Contains the info if dither is positive or negative
   uint16_t 	duty_cycle;				// Contains the currently valid duty cycle
   uint16_t 	pwm_period;				// Contains the period time in ms
+  uint16_t	dither_half;			// Overflows per half dither period, (dither_counts + 1) / 2
+  uint16_t	cnv_high;				// Compare value of duty + dither, see ftm_dither_update
+  uint16_t	cnv_low;				// Compare value of duty - dither
+  uint16_t	cnv_mod;				// FTM modulo the compare values have been calculated for
 }struct_pwm_vals_def;
 
 /* Global array which contains all values needed to handle the dither feature */
@@ -53,12 +57,26 @@ uint32_t change_pin_to_ftm(enum_pin_name pin);
 uint32_t change_pin_to_adc(enum_pin_name pin);
 
 
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Takes over the dither settings of pwm_vals_t[pin]
+* \details  Adds the pin to the dither list of its FTM module if dither_promille is not 0, otherwise
+* 			removes it. The compare values of duty +/- dither are calculated here, so the overflow
+* 			interrupt only writes CnV. Called by user_pwm_set_dither after pwm_vals_t has been updated.
+*
+* \param    pin      [in] uint8_t	PWM pin (enum_pwm_pin_name)
+* \return   void
+*/
+void ftm_dither_update(uint8_t pin);
+
+
 /*----------------------------------------------------------------------------*/
 /**
 * \brief    Function which handles the dither adaptions at runtime
 * \details  This function will do the calculations to split the dither frequency as
 * 			well as the dither duty into a symmetrical dither around the the duty
-* 			cycle.
+* 			cycle. Only the pins in the dither list of the module are visited, their
+* 			precalculated compare values are written directly.
 *
 * 			It is called by each FTM module when a timer overflow interrupt
 * 			is triggered.
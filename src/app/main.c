@@ -43,7 +43,16 @@
 #include "user_code.h"
 #include "graph_code.h"
 #include "adc_app.h"
+#include "adc_capture.h"
+#include "shift_app.h"
+#include "debounce_app.h"
+#include "meter_app.h"
+#include "sched_app.h"
+#include "timer_app.h"
+#include "time_app.h"
+#include "prof_app.h"
 #include "lin_app.h"
+#include "lin_db_tables.h"
 #include "sci_app.h"
 #include "can_app.h"
 
@@ -51,6 +60,7 @@
 #include "sfl_can_db_tables_data.h"
 #include "sfl_can_db.h"
 #include "sfl_bl_protocol.h"
+#include "sfl_timer.h"
 
 // Include STD libs
 #include <string.h>
@@ -64,10 +74,31 @@
 
 // Private helper function
 void supporting_driver_init(void);
+static void main_timer_1ms(void);
+static void main_sched_init(void);
+static uint8_t main_task_bl_protocol(void);
+static uint8_t main_task_adc(void);
+static uint8_t main_task_adc_capture(void);
+static uint8_t main_task_can_in(void);
+#ifndef LIN_STACK_EMPTY
+static uint8_t main_task_lin(void);
+#endif
+static uint8_t main_task_meter(void);
+static uint8_t main_task_app(void);
+static uint8_t main_task_output(void);
+static uint8_t main_task_timer(void);
+#if PROF_APP_ENABLE
+static uint8_t main_task_prof_export(void);
+#endif
+
+// cycle of usercode/graphcode, 0 = as often as possible (the task stays ready, see main_task_app)
+#define MAIN_APP_PERIOD_MS  ((ext_graph_cycle_time > 0u) ? ext_graph_cycle_time : 1u)
+
+static uint8_t multiplex_group;
+static uint8_t main_task_app_handle;
 
 int main(void)
 {
-	uint8_t multiplex_group;
 	// Clock initialization
 	CLOCK_SYS_Init(g_clockManConfigsArr, CLOCK_MANAGER_CONFIG_CNT, g_clockManCallbacksArr, CLOCK_MANAGER_CALLBACK_CNT);
 	CLOCK_SYS_UpdateConfiguration(0U, CLOCK_MANAGER_POLICY_AGREEMENT);
@@ -85,8 +116,9 @@ int main(void)
 
 	// Initialize the SYSTICK module with 1ms clock
 	hal_tick_init();
-	uint32_t current_sysTick_1ms = 0; // Declare variable for SYSTICK handling
-	uint32_t cycle_timestamp = 0;       // Timestamp variable for CycleTime
+
+	// 64 bit time base (LPIT0), before the first interrupt takes a timestamp
+	(void)time_app_init();
 
 	// Initialize the NVM (EEPROM) module
 	hal_nvm_init();
@@ -103,15 +135,21 @@ int main(void)
 	// Set predefined interrupt priorities
 	irq_priority_set_all_predefined();
 
+#if PROF_APP_ENABLE
+	// DWT cycle counter of the profiling, before the first interrupt is measured
+	prof_app_init();
+#endif
+
 	lin_init_all();
 
 	// Initialize modulehardwarecode
 	modulhardwarecode_init();
 
-#ifdef SET_CALLBACK_1MS_TIMER
-	// Initialize 1ms_timer callback
-	set_callback_timer_1ms(user_int_timer_1ms);
-#endif
+	// Output shift register, latches the initial state of the virtual pins
+	shift_app_init();
+
+	// Initialize 1ms_timer callback, time base, input debouncing, meters, software timers and user_int_timer_1ms
+	set_callback_timer_1ms(main_timer_1ms);
 
 #ifdef SET_CALLBACK_CAN_MESSAGE_RECEIVE
 	// Initialize can_msg_receive callback
@@ -128,60 +166,214 @@ int main(void)
 	// Initialize graphcode
 	graphcode_init();
 
+	// Register the tasks of the main loop and release them
+	main_sched_init();
+
 	// Start infinite loop
 	while(1)
 	{
 		// Signal event bit and request a kick
 		hal_watchdog_signal(WDT_SIGNAL_MAIN_LOOP_BIT | WATCHDOG_KICK_REQUEST);
 
-		// Get the current value of the 1ms timer
-		hal_get_timestamp(&current_sysTick_1ms, HAL_PRECISION_1MS);
+		// time of this pass, the same for all tasks run in it
+		sfl_timer_epoch_update();
+
+		// Run the ready task with the highest priority, sleep until the next interrupt if there is none
+		if (sched_app_run() == FALSE)
+		{
+			sched_app_idle();
+		}
+	}
+}
+
+// must be called prior to hal_pwm_init() and hal_freq_init()
+void supporting_driver_init(void)
+{
+	// Initialize the DMA (for SCI)
+	EDMA_DRV_Init(&dmaController1_State, &dmaController1_InitConfig0, edmaChnStateArray, edmaChnConfigArray, EDMA_CONFIGURED_CHANNELS_COUNT);
+}
+
+// 1ms timer interrupt
+static void main_timer_1ms(void)
+{
+	PROF_APP_BEGIN(PROF_SEC_ISR_TIMER_1MS);
 
-		// Maintain BL protocol state
-		(void)sfl_bl_protocol_s32k_cyclic();
+	// inline time base of sfl_timer first, the others may read it
+	sfl_timer_tick_1ms();
 
-		// update adc channels (e.g. those with calibration) in background
-		adc_processing(&multiplex_group, HW_CALIBRATION_SUPPORT);
+	// sample the debounced inputs and the meters
+	debounce_app_tick();
+	meter_app_tick();
+	// software timers count the ms, their callbacks run in the main loop
+	timer_app_tick();
 
+#ifdef SET_CALLBACK_1MS_TIMER
+	user_int_timer_1ms();
+#endif
 
-		/***********************************************************************************
-		 * Input
-		 ************************************************************************************/
-		sfl_can_queue_in_process();
+	PROF_APP_END(PROF_SEC_ISR_TIMER_1MS);
+}
 
-		lin_cyclic();
+// Tasks of the main loop, released by time and/or by the events of the interrupts.
+// Priority 0 is the highest, CAN input and the ADC values come before the housekeeping.
+// usercode/graphcode has the lowest priority: with ext_graph_cycle_time 0 it is always ready and
+// runs in every pass in which no other task is ready.
+static void main_sched_init(void)
+{
+	static const struct_sched_app_task_cfg_t task_cfg[] =
+	{
+		//  fn                      period  offset  prio    events                  budget_us
+		{ main_task_can_in,         5u,     0u,     0u,     SCHED_EVT_CAN_RX,       200u    },
+		{ main_task_adc,            5u,     0u,     1u,     SCHED_EVT_ADC_FRAME,    300u    },
+		{ main_task_bl_protocol,    1u,     0u,     2u,     SCHED_EVT_CAN_RX,       200u    },
+#ifndef LIN_STACK_EMPTY
+		{ main_task_lin,            1u,     0u,     2u,     0u,                     200u    },
+#endif
+		{ main_task_output,         1u,     0u,     3u,     SCHED_EVT_APP_DONE,     300u    },
+		{ main_task_timer,          0u,     0u,     4u,     SCHED_EVT_TIMER,        200u    },
+		{ main_task_meter,          10u,    5u,     5u,     0u,                     0u      },
+		{ main_task_adc_capture,    2u,     1u,     6u,     0u,                     0u      },
+#if PROF_APP_ENABLE
+		{ main_task_prof_export,    10u,    3u,     7u,     0u,                     0u      },
+#endif
+		{ main_task_app,            10u,    0u,     8u,     0u,                     0u      },
+	};
 
-		// Execute modulehardwarecode cyclic
-		modulhardwarecode_cyclic();
+	for (uint8_t k = 0u; k < (sizeof(task_cfg) / sizeof(task_cfg[0])); k++)
+	{
+		const uint8_t handle = sched_app_add(&task_cfg[k]);
 
-		/***********************************************************************************
-		 * Processing
-		 ************************************************************************************/
-		if ( (current_sysTick_1ms - cycle_timestamp) >= ext_graph_cycle_time)
+		if (task_cfg[k].fn == main_task_app)
 		{
-			// Take over current timestamp
-			cycle_timestamp = current_sysTick_1ms;
+			main_task_app_handle = handle;
+		}
+	}
 
-			// Execute usercode cyclic
-			usercode();
+	(void)sched_app_set_period(main_task_app_handle, MAIN_APP_PERIOD_MS);
+	sched_app_start();
+}
 
-			// Execute graphcode cyclic
-			graphcode();
-		}
+// Maintain BL protocol state, released at once by the frames for the protocol
+static uint8_t main_task_bl_protocol(void)
+{
+	PROF_APP_BEGIN(PROF_SEC_BL_PROTOCOL);
+	(void)sfl_bl_protocol_s32k_cyclic();
+	PROF_APP_END(PROF_SEC_BL_PROTOCOL);
+
+	return FALSE;
+}
 
+// update adc channels (e.g. those with calibration) with each new frame
+static uint8_t main_task_adc(void)
+{
+	PROF_APP_BEGIN(PROF_SEC_ADC_PROCESSING);
+	adc_processing(&multiplex_group, HW_CALIBRATION_SUPPORT);
+	PROF_APP_END(PROF_SEC_ADC_PROCESSING);
+
+	return FALSE;
+}
+
+// send a waveform capture in parts
+static uint8_t main_task_adc_capture(void)
+{
+	PROF_APP_BEGIN(PROF_SEC_ADC_CAPTURE);
+	adc_capture_readout_process();
+	PROF_APP_END(PROF_SEC_ADC_CAPTURE);
+
+	return FALSE;
+}
+
+// one frame per bus into the CAN DB, stays ready as long as a rx fifo isn't empty
+static uint8_t main_task_can_in(void)
+{
+	uint8_t more = FALSE;
 
-		/***********************************************************************************
-		 * Output
-		 ************************************************************************************/
-		// Cyclic CAN output
-		sfl_can_db_output_to_bus();
+	PROF_APP_BEGIN(PROF_SEC_CAN_IN);
+	sfl_can_queue_in_process();
+	PROF_APP_END(PROF_SEC_CAN_IN);
+
+	for (uint8_t bus = 0u; bus < CAN_BUS_MAX; bus++)
+	{
+		if (sfl_fifo_get_count(can_fifo_config_actual[bus]->rx_fifo_config) > 0u)
+		{
+			more = TRUE;
+		}
 	}
+
+	return more;
 }
 
-// must be called prior to hal_pwm_init() and hal_freq_init()
-void supporting_driver_init(void)
+#ifndef LIN_STACK_EMPTY
+// LIN receive queue, only with a LIN stack
+static uint8_t main_task_lin(void)
 {
-	// Initialize the DMA (for SCI)
-	EDMA_DRV_Init(&dmaController1_State, &dmaController1_InitConfig0, edmaChnStateArray, edmaChnConfigArray, EDMA_CONFIGURED_CHANNELS_COUNT);
+	PROF_APP_BEGIN(PROF_SEC_LIN);
+	lin_cyclic();
+	PROF_APP_END(PROF_SEC_LIN);
+
+	return FALSE;
 }
+#endif
+
+// integrate the samples of the meters, publish and persist the totals
+static uint8_t main_task_meter(void)
+{
+	PROF_APP_BEGIN(PROF_SEC_METER);
+	meter_app_process();
+	PROF_APP_END(PROF_SEC_METER);
+
+	return FALSE;
+}
+
+// usercode and graphcode every ext_graph_cycle_time, the outputs follow immediately.
+// With ext_graph_cycle_time 0 the task stays ready like in the loop without scheduler.
+static uint8_t main_task_app(void)
+{
+	PROF_APP_BEGIN(PROF_SEC_USERCODE);
+	usercode();
+	PROF_APP_END(PROF_SEC_USERCODE);
+	PROF_APP_BEGIN(PROF_SEC_GRAPHCODE);
+	graphcode();
+	PROF_APP_END(PROF_SEC_GRAPHCODE);
+
+	// ext_graph_cycle_time may be changed by the application
+	(void)sched_app_set_period(main_task_app_handle, MAIN_APP_PERIOD_MS);
+	sched_app_event_post(SCHED_EVT_APP_DONE);
+
+	return (ext_graph_cycle_time == 0u) ? TRUE : FALSE;
+}
+
+// Shift register of the virtual pins (only shifted if an output changed) and cyclic CAN output
+static uint8_t main_task_output(void)
+{
+	PROF_APP_BEGIN(PROF_SEC_SHIFT_OUT);
+	shift_app_process();
+	PROF_APP_END(PROF_SEC_SHIFT_OUT);
+	PROF_APP_BEGIN(PROF_SEC_CAN_OUT);
+	sfl_can_db_output_to_bus();
+	PROF_APP_END(PROF_SEC_CAN_OUT);
+
+	return FALSE;
+}
+
+// callbacks of the software timers, a limited number per run, stays ready while more are due
+static uint8_t main_task_timer(void)
+{
+	uint8_t more;
+
+	PROF_APP_BEGIN(PROF_SEC_TIMER);
+	more = timer_app_process();
+	PROF_APP_END(PROF_SEC_TIMER);
+
+	return more;
+}
+
+#if PROF_APP_ENABLE
+// profiling report, one section per call
+static uint8_t main_task_prof_export(void)
+{
+	(void)prof_app_export();
 
+	return FALSE;
+}
+#endif
@@ -0,0 +1,333 @@
+/*----------------------------------------------------------------------------*/
+/**
+ * \file         meter_app.c
+ * \brief        Integrating meters, e.g. operating hours, energy or duty hours
+ * \details      See meter_app.h
+ * \date         20261019
+ * \author       agent
+ *
+ */
+/*----------------------------------------------------------------------------*/
+#include "meter_app.h"
+#include "hal_pwm.h"
+#include "sfl_timer.h"
+#include "user_api_ai.h"
+#include "user_api_io.h"
+#include "user_api_can.h"
+#include "user_api_eeprom.h"
+#include "interrupt_manager.h"
+
+#define METER_APP_EE_CHECK          (0x4D455452uL)      // check word of a checkpoint: total ^ remainder ^ "METR"
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+typedef struct
+{
+    struct_meter_app_cfg_t cfg;
+    uint16_t countdown;                 // ticks to the next sample, timer interrupt only
+    uint32_t total;
+    uint32_t remainder;                 // numerator of the fraction of a unit, < gain_den
+    uint32_t published;                 // total written to the CAN DB signal
+    uint32_t persisted;                 // total of the last checkpoint
+    uint32_t persist_ts;                // timestamp of the last checkpoint in ms
+    uint8_t  changed;                   // total or remainder changed since the last checkpoint
+} struct_meter_app_t;
+
+// ===================================================================================================
+// Global data definitions
+// ===================================================================================================
+static struct_meter_app_t mgl_meter[METER_APP_CHN_MAX];
+static volatile uint8_t mgl_meter_cnt = 0u;                         // entries of mgl_meter in use
+static volatile uint64_t mgl_meter_accum[METER_APP_CHN_MAX];        // sum of the samples, written by the timer interrupt
+
+// ===================================================================================================
+// Internal function prototypes
+// ===================================================================================================
+static void meter_app_integrate(struct_meter_app_t *ptr_meter, uint8_t handle);
+static uint8_t meter_app_persist(struct_meter_app_t *ptr_meter, uint32_t now);
+
+// ===================================================================================================
+// Functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Takes over the accumulator of the timer interrupt and adds it to the total, the remainder of the
+* division carries over to the next call.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void meter_app_integrate(struct_meter_app_t *ptr_meter, uint8_t handle)
+{
+    uint64_t sum;
+
+    INT_SYS_DisableIRQGlobal();
+    sum = mgl_meter_accum[handle];
+    mgl_meter_accum[handle] = 0u;
+    INT_SYS_EnableIRQGlobal();
+
+    if (sum != 0u)
+    {
+        const uint64_t num = (sum * ptr_meter->cfg.gain_num) + ptr_meter->remainder;
+
+        ptr_meter->total += (uint32_t)(num / ptr_meter->cfg.gain_den);
+        ptr_meter->remainder = (uint32_t)(num % ptr_meter->cfg.gain_den);
+        ptr_meter->changed = TRUE;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Writes total, remainder and the check word.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static uint8_t meter_app_persist(struct_meter_app_t *ptr_meter, uint32_t now)
+{
+    uint8_t ret = FALSE;
+    uint32_t data[METER_APP_EE_SIZE / 4u];
+
+    data[0] = ptr_meter->total;
+    data[1] = ptr_meter->remainder;
+    data[2] = ptr_meter->total ^ ptr_meter->remainder ^ METER_APP_EE_CHECK;
+
+    if (user_eeprom_write_32bit(ptr_meter->cfg.ee_addr, METER_APP_EE_SIZE, data) == HAL_NVM_OK)
+    {
+        ptr_meter->persisted = ptr_meter->total;
+        ptr_meter->changed = FALSE;
+        ret = TRUE;
+    }
+    // also after an error, so a broken EEPROM isn't written in every main loop
+    ptr_meter->persist_ts = now;
+
+    return ret;
+}
+
+// ===================================================================================================
+// Public functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The entry is complete before the count includes it, the timer interrupt only samples counted entries.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t meter_app_add(const struct_meter_app_cfg_t *ptr_cfg)
+{
+    uint8_t handle = METER_APP_CHN_MAX;
+
+    if ( (ptr_cfg != NULL) && (mgl_meter_cnt < METER_APP_CHN_MAX) && (ptr_cfg->src < METER_SRC_MAX) &&
+         (ptr_cfg->sample_ms > 0u) && (ptr_cfg->gain_den > 0u) &&
+         ( (ptr_cfg->src != METER_SRC_FREQ) || ((ptr_cfg->pin > PWM_MAX) && (ptr_cfg->pin < FREQ_MAX)) ) &&
+         ( (ptr_cfg->src != METER_SRC_AI) || (ptr_cfg->pin < ADC_MAX) ) &&
+         ( (ptr_cfg->src != METER_SRC_CB) || (ptr_cfg->cb != NULL) ) )
+    {
+        struct_meter_app_t *ptr_meter = &mgl_meter[mgl_meter_cnt];
+        uint32_t data[METER_APP_EE_SIZE / 4u] = {0u};
+
+        ptr_meter->cfg = *ptr_cfg;
+        ptr_meter->countdown = ptr_cfg->sample_ms;
+        ptr_meter->total = 0u;
+        ptr_meter->remainder = 0u;
+
+        if ( (ptr_cfg->ee_addr != METER_APP_NO_EEPROM) &&
+             (user_eeprom_read_32bit(ptr_cfg->ee_addr, METER_APP_EE_SIZE, data) == HAL_NVM_OK) &&
+             (data[2] == (data[0] ^ data[1] ^ METER_APP_EE_CHECK)) && (data[1] < ptr_cfg->gain_den) )
+        {
+            ptr_meter->total = data[0];
+            ptr_meter->remainder = data[1];
+        }
+
+        ptr_meter->persisted = ptr_meter->total;
+        ptr_meter->published = ~ptr_meter->total;
+        ptr_meter->changed = FALSE;
+        (void)sfl_timer_set_timestamp(&ptr_meter->persist_ts, HAL_PRECISION_1MS);
+
+        handle = mgl_meter_cnt;
+        mgl_meter_accum[handle] = 0u;
+        mgl_meter_cnt++;
+    }
+
+    return handle;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint32_t meter_app_get(uint8_t handle)
+{
+    uint32_t total = 0u;
+
+    if (handle < mgl_meter_cnt)
+    {
+        total = mgl_meter[handle].total;
+    }
+
+    return total;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The samples which haven't been integrated yet are dropped, they belong to the old total.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t meter_app_set(uint8_t handle, uint32_t total)
+{
+    uint8_t ret = FALSE;
+
+    if (handle < mgl_meter_cnt)
+    {
+        struct_meter_app_t *ptr_meter = &mgl_meter[handle];
+
+        INT_SYS_DisableIRQGlobal();
+        mgl_meter_accum[handle] = 0u;
+        INT_SYS_EnableIRQGlobal();
+
+        ptr_meter->total = total;
+        ptr_meter->remainder = 0u;
+        ptr_meter->changed = TRUE;
+
+        if (ptr_meter->cfg.ee_addr != METER_APP_NO_EEPROM)
+        {
+            (void)meter_app_persist(ptr_meter, sfl_timer_now_ms());
+        }
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t meter_app_checkpoint(uint8_t handle)
+{
+    uint8_t ret = FALSE;
+
+    if ( (handle < mgl_meter_cnt) && (mgl_meter[handle].cfg.ee_addr != METER_APP_NO_EEPROM) )
+    {
+        meter_app_integrate(&mgl_meter[handle], handle);
+        ret = meter_app_persist(&mgl_meter[handle], sfl_timer_now_ms());
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Only sampling and one addition per meter, the division is done by meter_app_process.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void meter_app_tick(void)
+{
+    for (uint8_t k = 0u; k < mgl_meter_cnt; k++)
+    {
+        struct_meter_app_t *ptr_meter = &mgl_meter[k];
+
+        ptr_meter->countdown--;
+        if (ptr_meter->countdown == 0u)
+        {
+            uint32_t value = 0u;
+
+            ptr_meter->countdown = ptr_meter->cfg.sample_ms;
+
+            switch (ptr_meter->cfg.src)
+            {
+                case METER_SRC_FREQ:
+                    (void)hal_freq_get_freq(ptr_meter->cfg.pin, &value);
+                    break;
+                case METER_SRC_AI:
+                    value = user_ai_get_cal((enum_adc_pin_name)ptr_meter->cfg.pin);
+                    break;
+                case METER_SRC_DO:
+                    value = user_do_readback(ptr_meter->cfg.pin);
+                    break;
+                case METER_SRC_CB:
+                    value = ptr_meter->cfg.cb();
+                    break;
+                default:
+                    break;
+            }
+
+            if (ptr_meter->cfg.threshold > 0u)
+            {
+                value = (value >= ptr_meter->cfg.threshold) ? 1u : 0u;
+            }
+
+            mgl_meter_accum[k] += value;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void meter_app_process(void)
+{
+    const uint32_t now = sfl_timer_epoch_ms();
+
+    for (uint8_t k = 0u; k < mgl_meter_cnt; k++)
+    {
+        struct_meter_app_t *ptr_meter = &mgl_meter[k];
+
+        meter_app_integrate(ptr_meter, k);
+
+        if ( (ptr_meter->cfg.can_db_id != METER_APP_NO_SIGNAL) && (ptr_meter->total != ptr_meter->published) )
+        {
+            user_can_db_set_value(ptr_meter->cfg.can_db_id, ptr_meter->total);
+            ptr_meter->published = ptr_meter->total;
+        }
+
+        if ( (ptr_meter->cfg.ee_addr != METER_APP_NO_EEPROM) && (ptr_meter->changed == TRUE) )
+        {
+            if ( ( (ptr_meter->cfg.persist_units > 0u) &&
+                   ((ptr_meter->total - ptr_meter->persisted) >= ptr_meter->cfg.persist_units) ) ||
+                 ( (ptr_meter->cfg.persist_ms > 0u) && ((now - ptr_meter->persist_ts) >= ptr_meter->cfg.persist_ms) ) )
+            {
+                (void)meter_app_persist(ptr_meter, now);
+            }
+        }
+    }
+}
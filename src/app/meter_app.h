@@ -0,0 +1,135 @@
+#ifndef __METER_APP_H_
+#define __METER_APP_H_
+/*----------------------------------------------------------------------------*/
+/**
+* \file         meter_app.h
+* \brief        Integrating meters, e.g. operating hours, energy or duty hours
+* \details      A meter samples a source every sample_ms in the 1 ms timer and only adds the sample to an
+*               accumulator there. meter_app_process takes the accumulators over in the main loop and
+*               integrates them in fixed-point:
+*
+*                   total [unit] += sum(samples) * gain_num / gain_den
+*
+*               The remainder of the division is kept, so no fraction of a unit is lost however often it
+*               is called. With threshold > 0 a sample is 1 if the source is >= threshold and 0 otherwise,
+*               which turns e.g. a frequency into a running state.
+*
+*               Example: engine hours in 0.1 h, running above 400 Hz at FREQ_IN1, sampled every 100 ms
+*               - src = METER_SRC_FREQ, pin = FREQ_IN1, threshold = 400, sample_ms = 100
+*               - one sample = 100 ms = 1/3600 of 0.1 h: gain_num = 1, gain_den = 3600
+*
+*               Example: energy in Wh from a power in W (callback), sampled every 10 ms
+*               - one sample = W * 10 ms = W * 1/360000 Wh: gain_num = 1, gain_den = 360000
+*
+*               The total is written to a CAN DB signal when it changes. With an EEPROM address, the meter
+*               starts with the last checkpoint, and a checkpoint (total, remainder and a check word,
+*               METER_APP_EE_SIZE bytes) is written when the total has grown by persist_units or when it
+*               has changed and persist_ms has elapsed since the last checkpoint. meter_app_checkpoint
+*               writes one immediately, e.g. before the module goes to sleep.
+* \date         20261019
+* \author       agent
+*
+*/
+/*----------------------------------------------------------------------------*/
+
+#include "hal_data_types.h"
+#include "io_tables.h"
+
+
+// ===================================================================================================
+// Defines
+// ===================================================================================================
+#define METER_APP_CHN_MAX           (4u)                ///< meters
+#define METER_APP_NO_SIGNAL         (0xFFFFFFFFuL)      ///< can_db_id: no CAN DB signal
+#define METER_APP_NO_EEPROM         (0xFFFFFFFFuL)      ///< ee_addr: not persisted
+#define METER_APP_EE_SIZE           (12u)               ///< bytes of a checkpoint in the user EEPROM
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+typedef enum
+{
+    METER_SRC_FREQ = 0u,                ///< measured frequency of a FREQ input in Hz
+    METER_SRC_AI,                       ///< calibrated value of an analog input
+    METER_SRC_DO,                       ///< state of a digital output (user_do_readback)
+    METER_SRC_CB,                       ///< value returned by a callback
+    METER_SRC_MAX
+} enum_meter_src_t;
+
+/** Source callback, called in the 1 ms timer interrupt. */
+typedef uint32_t (*meter_app_source_cb_t)(void);
+
+typedef struct
+{
+    enum_meter_src_t src;
+    uint16_t pin;                       ///< FREQ_IN.., enum_adc_pin_name or DO pin, depending on src
+    meter_app_source_cb_t cb;           ///< METER_SRC_CB
+    uint32_t threshold;                 ///< 0: sample = source, else sample = (source >= threshold)
+    uint16_t sample_ms;                 ///< sample period 1..
+    uint32_t gain_num;                  ///< units per sample, numerator
+    uint32_t gain_den;                  ///< units per sample, denominator > 0
+    uint32_t can_db_id;                 ///< CAN DB signal of the total, METER_APP_NO_SIGNAL
+    uint32_t ee_addr;                   ///< user EEPROM address of the checkpoint, METER_APP_NO_EEPROM
+    uint32_t persist_units;             ///< checkpoint after this increase of the total, 0 = off
+    uint32_t persist_ms;                ///< checkpoint of a changed total after this time, 0 = off
+} struct_meter_app_cfg_t;
+
+// ===================================================================================================
+// Public function prototypes
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Adds a meter. It starts with the checkpoint in the EEPROM, or 0 if there is none.
+*
+* \param    ptr_cfg [in] const struct_meter_app_cfg_t*
+* \return   uint8_t                                     handle 0..METER_APP_CHN_MAX - 1, METER_APP_CHN_MAX if invalid or full
+*/
+uint8_t meter_app_add(const struct_meter_app_cfg_t *ptr_cfg);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Returns the total of a meter, 0 if the handle is invalid.
+*
+* \param    handle  [in] uint8_t
+* \return   uint32_t
+*/
+uint32_t meter_app_get(uint8_t handle);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Sets the total of a meter (e.g. reset of a trip meter), the remainder is cleared.
+* \details  The new total is persisted immediately.
+*
+* \param    handle  [in] uint8_t
+* \param    total   [in] uint32_t
+* \return   uint8_t                 FALSE if the handle is invalid
+*/
+uint8_t meter_app_set(uint8_t handle, uint32_t total);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Integrates the pending samples and writes a checkpoint now.
+*
+* \param    handle  [in] uint8_t
+* \return   uint8_t                 FALSE if the handle is invalid or the EEPROM write failed
+*/
+uint8_t meter_app_checkpoint(uint8_t handle);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Samples the sources which are due. Called by the 1 ms timer interrupt.
+*
+* \return   void
+*/
+void meter_app_tick(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Integrates the samples, publishes the totals and writes the checkpoints. Called in the main loop.
+*
+* \return   void
+*/
+void meter_app_process(void);
+
+#endif
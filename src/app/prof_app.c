@@ -0,0 +1,324 @@
+/*----------------------------------------------------------------------------*/
+/**
+ * \file         prof_app.c
+ * \brief        Profiling of main loop tasks and interrupts with the DWT cycle counter
+ * \details      See prof_app.h
+ * \date         20261019
+ * \author       agent
+ *
+ */
+/*----------------------------------------------------------------------------*/
+#include "prof_app.h"
+
+#if PROF_APP_ENABLE
+#include "clock_manager.h"
+#include "interrupt_manager.h"
+#include "sfl_timer.h"
+#include "user_api_can.h"
+#include "sci_app.h"
+
+#define PROF_APP_LINE_LEN           (128u)              // bytes of a text line
+
+// ===================================================================================================
+// Global data definitions
+// ===================================================================================================
+static struct_prof_app_stat_t mgl_prof_stat[PROF_SEC_MAX];
+static uint32_t mgl_prof_cycles_per_us = 1u;
+static uint32_t mgl_prof_round_ts = 0u;                             // start of the current export round in ms
+static uint8_t mgl_prof_export_sec = PROF_SEC_MAX;                  // next section of the round, PROF_SEC_MAX = none
+
+// ===================================================================================================
+// Internal function prototypes
+// ===================================================================================================
+static void prof_app_clear(struct_prof_app_stat_t *ptr_stat);
+static uint16_t prof_app_to_100ns(uint64_t cycles);
+static uint8_t prof_app_put_dec(uint8_t *ptr_buf, uint8_t pos, uint32_t value, uint8_t decimals);
+static uint8_t prof_app_put_str(uint8_t *ptr_buf, uint8_t pos, const char *ptr_str);
+
+// ===================================================================================================
+// Functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void prof_app_clear(struct_prof_app_stat_t *ptr_stat)
+{
+    ptr_stat->count = 0u;
+    ptr_stat->min = 0xFFFFFFFFuL;
+    ptr_stat->max = 0u;
+    ptr_stat->sum = 0u;
+    for (uint8_t k = 0u; k < PROF_APP_BUCKETS; k++)
+    {
+        ptr_stat->hist[k] = 0u;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static uint16_t prof_app_to_100ns(uint64_t cycles)
+{
+    const uint64_t t = (cycles * 10u) / mgl_prof_cycles_per_us;
+
+    return (t > 0xFFFFu) ? 0xFFFFu : (uint16_t)t;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Writes value / 10^decimals as decimal number, no printf (its size in the flash isn't worth it here).
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static uint8_t prof_app_put_dec(uint8_t *ptr_buf, uint8_t pos, uint32_t value, uint8_t decimals)
+{
+    uint8_t digits[10];
+    uint8_t n = 0u;
+
+    do
+    {
+        digits[n] = (uint8_t)('0' + (value % 10u));
+        value /= 10u;
+        n++;
+    } while ( (value > 0u) || (n <= decimals) );
+
+    while ( (n > 0u) && (pos < (PROF_APP_LINE_LEN - 1u)) )
+    {
+        n--;
+        ptr_buf[pos] = digits[n];
+        pos++;
+        if ( (n == decimals) && (decimals > 0u) && (pos < (PROF_APP_LINE_LEN - 1u)) )
+        {
+            ptr_buf[pos] = '.';
+            pos++;
+        }
+    }
+
+    return pos;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static uint8_t prof_app_put_str(uint8_t *ptr_buf, uint8_t pos, const char *ptr_str)
+{
+    while ( (*ptr_str != '\0') && (pos < (PROF_APP_LINE_LEN - 1u)) )
+    {
+        ptr_buf[pos] = (uint8_t)*ptr_str;
+        pos++;
+        ptr_str++;
+    }
+
+    return pos;
+}
+
+// ===================================================================================================
+// Public functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void prof_app_init(void)
+{
+    uint32_t core_clock = 0u;
+
+    if ( (STATUS_SUCCESS == CLOCK_SYS_GetFreq(CORE_CLOCK, &core_clock)) && (core_clock >= 1000000u) )
+    {
+        mgl_prof_cycles_per_us = core_clock / 1000000u;
+    }
+
+    for (uint8_t k = 0u; k < PROF_SEC_MAX; k++)
+    {
+        prof_app_clear(&mgl_prof_stat[k]);
+    }
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0u;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    (void)sfl_timer_set_timestamp(&mgl_prof_round_ts, HAL_PRECISION_1MS);
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Not locked: a section is either recorded in the main loop or in one interrupt, which doesn't
+* preempt itself. prof_app_get locks against the interrupts.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void prof_app_record(enum_prof_sec_t section, uint32_t cycles)
+{
+    if (section < PROF_SEC_MAX)
+    {
+        struct_prof_app_stat_t *ptr_stat = &mgl_prof_stat[section];
+        const uint32_t scaled = cycles >> PROF_APP_BUCKET_SHIFT;
+        uint32_t bucket = (scaled == 0u) ? 0u : (32u - (uint32_t)__builtin_clz(scaled));
+
+        if (bucket >= PROF_APP_BUCKETS)
+        {
+            bucket = PROF_APP_BUCKETS - 1u;
+        }
+
+        ptr_stat->count++;
+        ptr_stat->sum += cycles;
+        ptr_stat->hist[bucket]++;
+        if (cycles < ptr_stat->min)
+        {
+            ptr_stat->min = cycles;
+        }
+        if (cycles > ptr_stat->max)
+        {
+            ptr_stat->max = cycles;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t prof_app_get(enum_prof_sec_t section, struct_prof_app_stat_t *ptr_stat, uint8_t reset)
+{
+    uint8_t ret = FALSE;
+
+    if ( (section < PROF_SEC_MAX) && (ptr_stat != NULL) )
+    {
+        INT_SYS_DisableIRQGlobal();
+        *ptr_stat = mgl_prof_stat[section];
+        if (reset == TRUE)
+        {
+            prof_app_clear(&mgl_prof_stat[section]);
+        }
+        INT_SYS_EnableIRQGlobal();
+
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Sections without a measurement in the window are skipped.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t prof_app_export(void)
+{
+    uint8_t ret = FALSE;
+    const uint32_t now = sfl_timer_epoch_ms();
+
+    if ( (mgl_prof_export_sec >= PROF_SEC_MAX) && ((now - mgl_prof_round_ts) >= PROF_APP_EXPORT_MS) )
+    {
+        mgl_prof_round_ts = now;
+        mgl_prof_export_sec = 0u;
+    }
+
+    while ( (mgl_prof_export_sec < PROF_SEC_MAX) && (ret == FALSE) )
+    {
+        const uint8_t section = mgl_prof_export_sec;
+        struct_prof_app_stat_t stat;
+
+        mgl_prof_export_sec++;
+        (void)prof_app_get((enum_prof_sec_t)section, &stat, TRUE);
+
+        if (stat.count > 0u)
+        {
+            const uint16_t count = (stat.count > 0xFFFFu) ? 0xFFFFu : (uint16_t)stat.count;
+            const uint16_t t_min = prof_app_to_100ns(stat.min);
+            const uint16_t t_mean = prof_app_to_100ns(stat.sum / stat.count);
+            const uint16_t t_max = prof_app_to_100ns(stat.max);
+            uint8_t share[PROF_APP_BUCKETS];
+
+            for (uint8_t k = 0u; k < PROF_APP_BUCKETS; k++)
+            {
+                share[k] = (uint8_t)(((uint64_t)stat.hist[k] * 100u) / stat.count);
+            }
+
+#if (PROF_APP_EXPORT_CAN_BUS != PROF_APP_NO_EXPORT)
+            (void)user_can_msg_send(PROF_APP_EXPORT_CAN_BUS, PROF_APP_EXPORT_CAN_ID + (2u * section), EXTENDED_ID, 8u,
+                                    (uint8_t)count, (uint8_t)(count >> 8), (uint8_t)t_min, (uint8_t)(t_min >> 8),
+                                    (uint8_t)t_mean, (uint8_t)(t_mean >> 8), (uint8_t)t_max, (uint8_t)(t_max >> 8));
+            (void)user_can_msg_buffer_send(PROF_APP_EXPORT_CAN_BUS, PROF_APP_EXPORT_CAN_ID + (2u * section) + 1u,
+                                           EXTENDED_ID, PROF_APP_BUCKETS, share);
+#endif
+
+#if (PROF_APP_EXPORT_SCI != PROF_APP_NO_EXPORT)
+            {
+                // e.g. "P03 n=120 min=1.2 mean=3.4 max=10.0 us h=90,8,2,0,0,0,0,0"
+                static uint8_t line[PROF_APP_LINE_LEN];
+                uint8_t pos = 0u;
+
+                pos = prof_app_put_str(line, pos, "P");
+                pos = prof_app_put_dec(line, pos, section / 10u, 0u);
+                pos = prof_app_put_dec(line, pos, section % 10u, 0u);
+                pos = prof_app_put_str(line, pos, " n=");
+                pos = prof_app_put_dec(line, pos, stat.count, 0u);
+                pos = prof_app_put_str(line, pos, " min=");
+                pos = prof_app_put_dec(line, pos, t_min, 1u);
+                pos = prof_app_put_str(line, pos, " mean=");
+                pos = prof_app_put_dec(line, pos, t_mean, 1u);
+                pos = prof_app_put_str(line, pos, " max=");
+                pos = prof_app_put_dec(line, pos, t_max, 1u);
+                pos = prof_app_put_str(line, pos, " us h=");
+                for (uint8_t k = 0u; k < PROF_APP_BUCKETS; k++)
+                {
+                    pos = prof_app_put_dec(line, pos, share[k], 0u);
+                    pos = prof_app_put_str(line, pos, (k < (PROF_APP_BUCKETS - 1u)) ? "," : "\r\n");
+                }
+
+                (void)sci_tx_send(PROF_APP_EXPORT_SCI, line, pos);
+            }
+#else
+            (void)share;
+#endif
+            ret = TRUE;
+        }
+    }
+
+    return ret;
+}
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef __PROF_APP_H_
+#define __PROF_APP_H_
+/*----------------------------------------------------------------------------*/
+/**
+* \file         prof_app.h
+* \brief        Profiling of main loop tasks and interrupts with the DWT cycle counter
+* \details      A section is measured with PROF_APP_BEGIN / PROF_APP_END in core clock cycles (DWT CYCCNT,
+*               one register read each). Per section count, min, max, sum and a histogram are kept in
+*               static memory:
+*
+*                   bucket 0:   cycles <  2^PROF_APP_BUCKET_SHIFT
+*                   bucket k:   cycles >= 2^(PROF_APP_BUCKET_SHIFT + k - 1), < 2^(PROF_APP_BUCKET_SHIFT + k)
+*                   last:       everything above
+*
+*               A section of the main loop includes the interrupts which preempted it.
+*
+*               prof_app_export sends one section per call and resets it afterwards, a report therefore
+*               covers the time since the previous one. A round over all sections starts every
+*               PROF_APP_EXPORT_MS. Times are sent in 0.1 us, saturated to 0xFFFF.
+*               - CAN, extended id PROF_APP_EXPORT_CAN_ID + 2 * section, little endian:
+*                 count (u16), min (u16), mean (u16), max (u16)
+*               - CAN, extended id PROF_APP_EXPORT_CAN_ID + 2 * section + 1:
+*                 share of the buckets 0..7 in % (u8 each)
+*               - UART (PROF_APP_EXPORT_SCI): one text line per section
+*
+*               With PROF_APP_ENABLE 0 (default, release builds) the macros are empty and nothing of the
+*               module is compiled. Enable it e.g. with -DPROF_APP_ENABLE=1 in a debug build.
+* \date         20261019
+* \author       agent
+*
+*/
+/*----------------------------------------------------------------------------*/
+
+#include "hal_data_types.h"
+
+
+// ===================================================================================================
+// Defines
+// ===================================================================================================
+#ifndef PROF_APP_ENABLE
+#define PROF_APP_ENABLE             (0)                 ///< 0 removes the profiling at compile time
+#endif
+#define PROF_APP_BUCKETS            (8u)                ///< histogram buckets
+#ifndef PROF_APP_BUCKET_SHIFT
+#define PROF_APP_BUCKET_SHIFT       (8u)                ///< upper limit of bucket 0: 2^shift cycles
+#endif
+#ifndef PROF_APP_EXPORT_MS
+#define PROF_APP_EXPORT_MS          (1000u)             ///< period of an export round
+#endif
+#ifndef PROF_APP_EXPORT_CAN_BUS
+#define PROF_APP_EXPORT_CAN_BUS     (0u)                ///< CAN bus of the diagnostic frames, PROF_APP_NO_EXPORT = off
+#endif
+#ifndef PROF_APP_EXPORT_CAN_ID
+#define PROF_APP_EXPORT_CAN_ID      (0x1FFFFF00uL)      ///< first extended id of the diagnostic frames
+#endif
+#ifndef PROF_APP_EXPORT_SCI
+#define PROF_APP_EXPORT_SCI         PROF_APP_NO_EXPORT  ///< SCI interface of the text lines, PROF_APP_NO_EXPORT = off
+#endif
+#define PROF_APP_NO_EXPORT          (0xFFu)
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+typedef enum
+{
+    PROF_SEC_BL_PROTOCOL = 0u,          ///< sfl_bl_protocol_s32k_cyclic
+    PROF_SEC_ADC_PROCESSING,            ///< adc_processing
+    PROF_SEC_ADC_CAPTURE,               ///< adc_capture_readout_process
+    PROF_SEC_CAN_IN,                    ///< sfl_can_queue_in_process
+    PROF_SEC_LIN,                       ///< lin_cyclic
+    PROF_SEC_METER,                     ///< meter_app_process
+    PROF_SEC_USERCODE,                  ///< usercode
+    PROF_SEC_GRAPHCODE,                 ///< graphcode
+    PROF_SEC_SHIFT_OUT,                 ///< shift_app_process
+    PROF_SEC_CAN_OUT,                   ///< sfl_can_db_output_to_bus
+    PROF_SEC_ISR_ADC,                   ///< ADC_IRQHandler
+    PROF_SEC_ISR_FTM,                   ///< FTM_IRQHandler
+    PROF_SEC_ISR_CAN,                   ///< CAN_Callback, CAN2_Callback, CAN3_Callback
+    PROF_SEC_ISR_TIMER_1MS,             ///< 1 ms timer callback
+    PROF_SEC_TIMER,                     ///< timer_app_process, software timer callbacks
+    PROF_SEC_MAX
+} enum_prof_sec_t;
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;                       ///< cycles
+    uint32_t max;                       ///< cycles
+    uint64_t sum;                       ///< cycles
+    uint32_t hist[PROF_APP_BUCKETS];
+} struct_prof_app_stat_t;
+
+// ===================================================================================================
+// Macros
+// ===================================================================================================
+#if PROF_APP_ENABLE
+#include "device_registers.h"
+#include "core_cm4.h"
+
+/** Starts a section, a declaration: once per section and block. */
+#define PROF_APP_BEGIN(section)     const uint32_t prof_app_ts_##section = DWT->CYCCNT
+/** Ends a section started in the same block. */
+#define PROF_APP_END(section)       prof_app_record((section), DWT->CYCCNT - prof_app_ts_##section)
+#else
+#define PROF_APP_BEGIN(section)
+#define PROF_APP_END(section)
+#endif
+
+#if PROF_APP_ENABLE
+// ===================================================================================================
+// Public function prototypes
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Starts the DWT cycle counter and clears all sections.
+*
+* \return   void
+*/
+void prof_app_init(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Adds a measurement to a section, called by PROF_APP_END.
+*
+* \param    section [in] enum_prof_sec_t
+* \param    cycles  [in] uint32_t
+* \return   void
+*/
+void prof_app_record(enum_prof_sec_t section, uint32_t cycles);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Copies the statistics of a section.
+*
+* \param    section     [in]  enum_prof_sec_t
+* \param    ptr_stat    [out] struct_prof_app_stat_t*
+* \param    reset       [in]  uint8_t                   TRUE: clear the section afterwards
+* \return   uint8_t                                     FALSE if the section is invalid
+*/
+uint8_t prof_app_get(enum_prof_sec_t section, struct_prof_app_stat_t *ptr_stat, uint8_t reset);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Exports the next section of a round if one is due. Called in the main loop, e.g. every 10 ms,
+*           so the frames and lines of a round are spread over several calls.
+*
+* \return   uint8_t     TRUE if a section has been exported
+*/
+uint8_t prof_app_export(void);
+#endif
+
+#endif
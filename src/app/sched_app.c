@@ -0,0 +1,449 @@
+/*----------------------------------------------------------------------------*/
+/**
+ * \file         sched_app.c
+ * \brief        Cooperative run-to-completion scheduler of the main loop
+ * \details      See sched_app.h
+ * \date         20261019
+ * \author       agent
+ *
+ */
+/*----------------------------------------------------------------------------*/
+#include "sched_app.h"
+#include "sfl_timer.h"
+#include "time_app.h"
+#include "interrupt_manager.h"
+#include "device_registers.h"
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+typedef struct
+{
+    struct_sched_app_task_cfg_t cfg;
+    struct_sched_app_task_stat_t stat;
+    uint32_t release;                   // next release in ms, periodic tasks
+    uint32_t pending;                   // events received since the last run
+    uint32_t pending_ts;                // time_app ticks, first event posted since the last run
+    uint8_t  more;                      // the last run returned TRUE
+} struct_sched_app_task_t;
+
+// ===================================================================================================
+// Global data definitions
+// ===================================================================================================
+static struct_sched_app_task_t mgl_sched_task[SCHED_APP_TASK_MAX];
+static uint8_t mgl_sched_cnt = 0u;
+static volatile uint32_t mgl_sched_events = 0u;                     // posted by interrupts, taken by sched_app_run
+static volatile uint32_t mgl_sched_post_ts = 0u;                    // time_app ticks, first post since the events were taken
+static struct_sched_app_idle_stat_t mgl_sched_idle = {0u, 0u};      // last complete window
+static uint32_t mgl_sched_idle_us = 0u;                             // asleep in the current window
+static uint32_t mgl_sched_idle_sleeps = 0u;
+static uint32_t mgl_sched_window_ts = 0u;                           // ms, start of the current window
+
+// ===================================================================================================
+// Internal function prototypes
+// ===================================================================================================
+static void sched_app_collect(void);
+static uint8_t sched_app_is_ready(const struct_sched_app_task_t *ptr_task, uint32_t now);
+static uint32_t sched_app_release_in(uint32_t now);
+static void sched_app_idle_window(uint32_t now);
+
+// ===================================================================================================
+// Functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Takes the posted events and hands them to the tasks waiting for them. A task which had no event
+* pending yet takes over the time of the first post.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void sched_app_collect(void)
+{
+    uint32_t events;
+    uint32_t post_ts;
+
+    INT_SYS_DisableIRQGlobal();
+    events = mgl_sched_events;
+    post_ts = mgl_sched_post_ts;
+    mgl_sched_events = 0u;
+    INT_SYS_EnableIRQGlobal();
+
+    if (events != 0u)
+    {
+        for (uint8_t k = 0u; k < mgl_sched_cnt; k++)
+        {
+            struct_sched_app_task_t *ptr_task = &mgl_sched_task[k];
+
+            if ( (ptr_task->pending == 0u) && ((events & ptr_task->cfg.events) != 0u) )
+            {
+                ptr_task->pending_ts = post_ts;
+            }
+            ptr_task->pending |= events & ptr_task->cfg.events;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static uint8_t sched_app_is_ready(const struct_sched_app_task_t *ptr_task, uint32_t now)
+{
+    return ( (ptr_task->more == TRUE) || (ptr_task->pending != 0u) ||
+             ( (ptr_task->cfg.period_ms > 0u) && ((int32_t)(now - ptr_task->release) >= 0) ) ) ? TRUE : FALSE;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Without taking the posted events, callable with the interrupts disabled.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static uint32_t sched_app_release_in(uint32_t now)
+{
+    uint32_t next = 0xFFFFFFFFuL;
+
+    for (uint8_t k = 0u; (k < mgl_sched_cnt) && (next > 0u); k++)
+    {
+        const struct_sched_app_task_t *ptr_task = &mgl_sched_task[k];
+
+        if (sched_app_is_ready(ptr_task, now) == TRUE)
+        {
+            next = 0u;
+        }
+        else if ( (ptr_task->cfg.period_ms > 0u) && ((ptr_task->release - now) < next) )
+        {
+            next = ptr_task->release - now;
+        }
+    }
+
+    return next;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Closes the idle window after SCHED_APP_IDLE_WINDOW_MS, us asleep per ms is the share in permille.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void sched_app_idle_window(uint32_t now)
+{
+    const uint32_t window_ms = now - mgl_sched_window_ts;
+
+    if (window_ms >= SCHED_APP_IDLE_WINDOW_MS)
+    {
+        const uint32_t permille = mgl_sched_idle_us / window_ms;
+
+        mgl_sched_idle.idle_permille = (permille > 1000u) ? 1000u : (uint16_t)permille;
+        mgl_sched_idle.sleeps = mgl_sched_idle_sleeps;
+        mgl_sched_idle_us = 0u;
+        mgl_sched_idle_sleeps = 0u;
+        mgl_sched_window_ts = now;
+    }
+}
+
+// ===================================================================================================
+// Public functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t sched_app_add(const struct_sched_app_task_cfg_t *ptr_cfg)
+{
+    uint8_t handle = SCHED_APP_TASK_MAX;
+
+    if ( (ptr_cfg != NULL) && (ptr_cfg->fn != NULL) && (mgl_sched_cnt < SCHED_APP_TASK_MAX) &&
+         ( (ptr_cfg->period_ms > 0u) || (ptr_cfg->events != 0u) ) )
+    {
+        struct_sched_app_task_t *ptr_task = &mgl_sched_task[mgl_sched_cnt];
+
+        ptr_task->cfg = *ptr_cfg;
+        ptr_task->stat.runs = 0u;
+        ptr_task->stat.overruns = 0u;
+        ptr_task->stat.misses = 0u;
+        ptr_task->stat.exec_last_us = 0u;
+        ptr_task->stat.exec_max_us = 0u;
+        ptr_task->stat.latency_last_us = 0u;
+        ptr_task->stat.latency_max_us = 0u;
+        ptr_task->release = 0u;
+        ptr_task->pending = 0u;
+        ptr_task->pending_ts = 0u;
+        ptr_task->more = FALSE;
+
+        handle = mgl_sched_cnt;
+        mgl_sched_cnt++;
+    }
+
+    return handle;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void sched_app_start(void)
+{
+    uint32_t now = 0u;
+
+    (void)sfl_timer_set_timestamp(&now, HAL_PRECISION_1MS);
+
+    for (uint8_t k = 0u; k < mgl_sched_cnt; k++)
+    {
+        mgl_sched_task[k].release = now + mgl_sched_task[k].cfg.offset_ms;
+    }
+    mgl_sched_window_ts = now;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* A task which had no period starts its releases now.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t sched_app_set_period(uint8_t handle, uint16_t period_ms)
+{
+    uint8_t ret = FALSE;
+
+    if ( (handle < mgl_sched_cnt) && ( (period_ms > 0u) || (mgl_sched_task[handle].cfg.events != 0u) ) )
+    {
+        struct_sched_app_task_t *ptr_task = &mgl_sched_task[handle];
+
+        if (ptr_task->cfg.period_ms == 0u)
+        {
+            (void)sfl_timer_set_timestamp(&ptr_task->release, HAL_PRECISION_1MS);
+        }
+        ptr_task->cfg.period_ms = period_ms;
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Atomic OR (LDREX/STREX), an interrupt of a higher priority posting meanwhile doesn't get lost.
+* The first post after the events have been taken sets the time for the latency.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void sched_app_event_post(uint32_t events)
+{
+    const uint32_t now = time_app_ticks32();
+
+    if (__atomic_fetch_or(&mgl_sched_events, events, __ATOMIC_RELEASE) == 0u)
+    {
+        mgl_sched_post_ts = now;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Event-only tasks have their deadline now, so among the tasks of one priority they come before the
+* periodic ones which are not late. The releases a periodic task has missed are counted and skipped.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t sched_app_run(void)
+{
+    uint8_t best = SCHED_APP_TASK_MAX;
+    uint32_t best_deadline = 0u;
+    const uint32_t now = sfl_timer_epoch_ms();
+
+    sched_app_collect();
+    sched_app_idle_window(now);
+
+    for (uint8_t k = 0u; k < mgl_sched_cnt; k++)
+    {
+        const struct_sched_app_task_t *ptr_task = &mgl_sched_task[k];
+
+        if (sched_app_is_ready(ptr_task, now) == TRUE)
+        {
+            const uint32_t deadline = (ptr_task->cfg.period_ms > 0u) ? ptr_task->release : now;
+
+            if ( (best == SCHED_APP_TASK_MAX) || (ptr_task->cfg.prio < mgl_sched_task[best].cfg.prio) ||
+                 ( (ptr_task->cfg.prio == mgl_sched_task[best].cfg.prio) && ((int32_t)(deadline - best_deadline) < 0) ) )
+            {
+                best = k;
+                best_deadline = deadline;
+            }
+        }
+    }
+
+    if (best < SCHED_APP_TASK_MAX)
+    {
+        struct_sched_app_task_t *ptr_task = &mgl_sched_task[best];
+        const uint32_t pending = ptr_task->pending;
+        uint32_t start = 0u;
+        uint32_t end = 0u;
+
+        if ( (ptr_task->cfg.period_ms > 0u) && ((int32_t)(now - ptr_task->release) >= 0) )
+        {
+            const uint32_t missed = (now - ptr_task->release) / ptr_task->cfg.period_ms;
+
+            ptr_task->stat.misses += missed;
+            ptr_task->release += ptr_task->cfg.period_ms * (missed + 1u);
+        }
+        ptr_task->pending = 0u;
+
+        start = time_app_ticks32();
+        if (pending != 0u)
+        {
+            ptr_task->stat.latency_last_us = time_app_ticks_to_us(start - ptr_task->pending_ts);
+            if (ptr_task->stat.latency_last_us > ptr_task->stat.latency_max_us)
+            {
+                ptr_task->stat.latency_max_us = ptr_task->stat.latency_last_us;
+            }
+        }
+        ptr_task->more = ptr_task->cfg.fn();
+        end = time_app_ticks32();
+
+        ptr_task->stat.runs++;
+        ptr_task->stat.exec_last_us = time_app_ticks_to_us(end - start);
+        if (ptr_task->stat.exec_last_us > ptr_task->stat.exec_max_us)
+        {
+            ptr_task->stat.exec_max_us = ptr_task->stat.exec_last_us;
+        }
+        if ( (ptr_task->cfg.budget_us > 0u) && (ptr_task->stat.exec_last_us > ptr_task->cfg.budget_us) )
+        {
+            ptr_task->stat.overruns++;
+        }
+    }
+
+    return (best < SCHED_APP_TASK_MAX) ? TRUE : FALSE;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint32_t sched_app_next_release_ms(void)
+{
+    const uint32_t now = sfl_timer_now_ms();
+
+    sched_app_collect();
+
+    return sched_app_release_in(now);
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* WFI wakes up on a pending interrupt also with the interrupts disabled (PRIMASK), the interrupt runs
+* after they are enabled again. The sleep is measured around, including the interrupt which woke up.
+* Normal sleep mode (SLEEPDEEP not set), the peripherals and the 1 ms tick keep running.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void sched_app_idle(void)
+{
+    const uint32_t now = sfl_timer_now_ms();
+    uint32_t start = 0u;
+    uint32_t end = 0u;
+    uint8_t slept = FALSE;
+
+    start = time_app_ticks32();
+
+    INT_SYS_DisableIRQGlobal();
+    if ( (mgl_sched_events == 0u) && (sched_app_release_in(now) > 0u) )
+    {
+        STANDBY();
+        slept = TRUE;
+    }
+    INT_SYS_EnableIRQGlobal();
+
+    if (slept == TRUE)
+    {
+        end = time_app_ticks32();
+        mgl_sched_idle_us += time_app_ticks_to_us(end - start);
+        mgl_sched_idle_sleeps++;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t sched_app_get_stat(uint8_t handle, struct_sched_app_task_stat_t *ptr_stat)
+{
+    uint8_t ret = FALSE;
+
+    if ( (handle < mgl_sched_cnt) && (ptr_stat != NULL) )
+    {
+        *ptr_stat = mgl_sched_task[handle].stat;
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void sched_app_get_idle(struct_sched_app_idle_stat_t *ptr_stat)
+{
+    if (ptr_stat != NULL)
+    {
+        *ptr_stat = mgl_sched_idle;
+    }
+}
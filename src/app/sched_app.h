@@ -0,0 +1,165 @@
+#ifndef __SCHED_APP_H_
+#define __SCHED_APP_H_
+/*----------------------------------------------------------------------------*/
+/**
+* \file         sched_app.h
+* \brief        Cooperative run-to-completion scheduler of the main loop
+* \details      Tasks are released by time (period and offset in ms) and/or by events posted from
+*               interrupts (e.g. a new ADC frame or a received CAN frame). sched_app_run runs one ready
+*               task per call: the one with the highest priority (lowest number), among those the one with
+*               the earliest deadline. The deadline of a periodic task is its next release.
+*
+*               A task returns TRUE if it has more work (e.g. more frames in a queue), it stays ready and
+*               is picked again without waiting for its next release.
+*
+*               Per task the execution time is measured in us with the LPIT time base (time_app). Accounting:
+*               - overruns: executions longer than the budget of the task
+*               - misses:   releases which have passed before the task ran (it runs once for all of them)
+*
+*               A task never preempts another one. Work which must not wait for the longest task stays
+*               in the interrupts (e.g. current_ctrl).
+*
+*               Idle: if no task is ready, sched_app_idle sleeps with WFI until the next interrupt. The
+*               check and the WFI run with the interrupts disabled, so an event posted in between wakes
+*               the core immediately. The 1 ms tick bounds a sleep, a periodic release is never late.
+*               Measured: the share of the time asleep per SCHED_APP_IDLE_WINDOW_MS and per task the
+*               latency from the interrupt posting an event to the start of the task it released.
+* \date         20261019
+* \author       agent
+*
+*/
+/*----------------------------------------------------------------------------*/
+
+#include "hal_data_types.h"
+
+
+// ===================================================================================================
+// Defines
+// ===================================================================================================
+#define SCHED_APP_TASK_MAX          (16u)               ///< tasks
+#define SCHED_APP_IDLE_WINDOW_MS    (1000u)             ///< window of the idle share
+
+#define SCHED_EVT_ADC_FRAME         (1uL << 0)          ///< ADC frame complete (interrupt or eDMA callback)
+#define SCHED_EVT_CAN_RX            (1uL << 1)          ///< CAN frame put into an rx fifo or handed to the bootloader protocol
+#define SCHED_EVT_APP_DONE          (1uL << 2)          ///< usercode / graphcode cycle done
+#define SCHED_EVT_TIMER             (1uL << 3)          ///< a software timer is due (timer_app)
+#define SCHED_EVT_USER              (1uL << 8)          ///< first event bit free for the application
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+
+/** Task function, returns TRUE if it has more work to do. */
+typedef uint8_t (*sched_app_task_fn_t)(void);
+
+typedef struct
+{
+    sched_app_task_fn_t fn;
+    uint16_t period_ms;                 ///< 0 = released by events only
+    uint16_t offset_ms;                 ///< first release after sched_app_start
+    uint8_t  prio;                      ///< 0 = highest
+    uint32_t events;                    ///< SCHED_EVT_.. which release the task, 0 = none
+    uint32_t budget_us;                 ///< execution time budget, 0 = none
+} struct_sched_app_task_cfg_t;
+
+typedef struct
+{
+    uint32_t runs;
+    uint32_t overruns;                  ///< executions longer than budget_us
+    uint32_t misses;                    ///< releases passed before the task ran
+    uint32_t exec_last_us;
+    uint32_t exec_max_us;
+    uint32_t latency_last_us;           ///< from the first event posted to the start, event releases only
+    uint32_t latency_max_us;
+} struct_sched_app_task_stat_t;
+
+typedef struct
+{
+    uint16_t idle_permille;             ///< time asleep in the last window
+    uint32_t sleeps;                    ///< WFI in the last window
+} struct_sched_app_idle_stat_t;
+
+// ===================================================================================================
+// Public function prototypes
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Registers a task, before sched_app_start.
+*
+* \param    ptr_cfg [in] const struct_sched_app_task_cfg_t*
+* \return   uint8_t                                         handle 0..SCHED_APP_TASK_MAX - 1, SCHED_APP_TASK_MAX if invalid or full
+*/
+uint8_t sched_app_add(const struct_sched_app_task_cfg_t *ptr_cfg);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Sets the first release of all tasks relative to now.
+*
+* \return   void
+*/
+void sched_app_start(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Changes the period of a task, taking effect with its next release.
+*
+* \param    handle      [in] uint8_t
+* \param    period_ms   [in] uint16_t
+* \return   uint8_t                     FALSE if the handle is invalid
+*/
+uint8_t sched_app_set_period(uint8_t handle, uint16_t period_ms);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Posts events, callable from interrupts.
+*
+* \param    events  [in] uint32_t   SCHED_EVT_..
+* \return   void
+*/
+void sched_app_event_post(uint32_t events);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Runs the ready task with the highest priority and the earliest deadline.
+*
+* \return   uint8_t     TRUE if a task has run, FALSE if no task was ready
+*/
+uint8_t sched_app_run(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Sleeps with WFI until the next interrupt if no task is ready. Called when sched_app_run returned FALSE.
+*
+* \return   void
+*/
+void sched_app_idle(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Time until the next release of a periodic task.
+*
+* \return   uint32_t    ms, 0 if a task is ready, 0xFFFFFFFF if there is no periodic task
+*/
+uint32_t sched_app_next_release_ms(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Copies the accounting of a task.
+*
+* \param    handle      [in]  uint8_t
+* \param    ptr_stat    [out] struct_sched_app_task_stat_t*
+* \return   uint8_t                                         FALSE if the handle is invalid
+*/
+uint8_t sched_app_get_stat(uint8_t handle, struct_sched_app_task_stat_t *ptr_stat);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Copies the idle accounting of the last complete window.
+*
+* \param    ptr_stat    [out] struct_sched_app_idle_stat_t*
+* \return   void
+*/
+void sched_app_get_idle(struct_sched_app_idle_stat_t *ptr_stat);
+
+#endif
@@ -0,0 +1,268 @@
+/*----------------------------------------------------------------------------*/
+/**
+ * \file         shift_app.c
+ * \brief        Output shift register of the virtual pins
+ * \details      See shift_app.h
+ * \date         20261019
+ * \author       agent
+ *
+ */
+/*----------------------------------------------------------------------------*/
+#include "shift_app.h"
+#include "hal_io.h"
+#include "sfl_timer.h"
+
+// ===================================================================================================
+// Global data definitions
+// ===================================================================================================
+static volatile uint8_t mgl_shift_dirty = TRUE;                     // set by user_do_set, cleared before the image is packed, fast path of shift_app_flush
+static uint8_t mgl_shift_valid = FALSE;                             // mgl_shift_latched is on the outputs
+static uint32_t mgl_shift_latched = 0u;                             // image of the outputs, bit k = virtual_pin[k]
+static uint32_t mgl_shift_refresh_ts = 0u;                          // timestamp of the last refresh
+static shift_app_verify_cb_t mgl_shift_verify_cb = NULL;
+
+// set/clear registers of the clock and data line, NULL if they are on different ports
+static GPIO_Type *mgl_shift_port = NULL;
+static uint32_t mgl_shift_clk_mask = 0u;
+static uint32_t mgl_shift_data_mask = 0u;
+
+// ===================================================================================================
+// Internal function prototypes
+// ===================================================================================================
+static uint32_t shift_app_pack(void);
+static void shift_app_write(uint32_t image);
+static void shift_app_update(uint8_t force);
+
+// ===================================================================================================
+// Functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Packs the outputs of virtual_pin into one word.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static uint32_t shift_app_pack(void)
+{
+    uint32_t image = 0u;
+
+    for (uint8_t k = 0u; k < SHIFT_OUTPUT_CHANNELS; k++)
+    {
+        image |= (uint32_t)(virtual_pin[k].current_val != 0u) << k;
+    }
+
+    return image;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Same sequence as modulhardwarecode_cyclic: storage clock low, bit 0 first with data set while the
+* shift clock is low and taken over with the rising edge, storage clock high. On one port a bit is
+* one clear (clock and a 0 bit), one set (a 1 bit) and one set (clock) store.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void shift_app_write(uint32_t image)
+{
+    (void)hal_io_do_set(DOX_SHIFT_ST_CP, 0u);
+
+    if (mgl_shift_port != NULL)
+    {
+        for (uint8_t k = 0u; k < SHIFT_OUTPUT_CHANNELS; k++)
+        {
+            const uint32_t data = ((image >> k) & 1u) ? mgl_shift_data_mask : 0u;
+
+            mgl_shift_port->PCOR = mgl_shift_clk_mask | (mgl_shift_data_mask & ~data);
+            mgl_shift_port->PSOR = data;
+            mgl_shift_port->PSOR = mgl_shift_clk_mask;
+        }
+    }
+    else
+    {
+        for (uint8_t k = 0u; k < SHIFT_OUTPUT_CHANNELS; k++)
+        {
+            (void)hal_io_do_set(DOX_SHIFT_SH_CP, 0u);
+            (void)hal_io_do_set(DOX_SHIFT_IN_DS, (uint8_t)((image >> k) & 1u));
+            (void)hal_io_do_set(DOX_SHIFT_SH_CP, 1u);
+        }
+    }
+
+    (void)hal_io_do_set(DOX_SHIFT_ST_CP, 1u);
+
+    // make sure the output is enabled
+    (void)hal_io_do_set(DOX_SHIFT_OE_N, 0u);
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The dirty flag is cleared before the image is packed, so a user_do_set in between (interrupt)
+* is taken over with the next call.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void shift_app_update(uint8_t force)
+{
+    uint32_t image;
+
+    mgl_shift_dirty = FALSE;
+    image = shift_app_pack();
+
+    if ( (force == TRUE) || (mgl_shift_valid == FALSE) || (image != mgl_shift_latched) )
+    {
+        shift_app_write(image);
+        mgl_shift_latched = image;
+        mgl_shift_valid = TRUE;
+
+        if (mgl_shift_verify_cb != NULL)
+        {
+            mgl_shift_verify_cb(image);
+        }
+    }
+}
+
+// ===================================================================================================
+// Public functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void shift_app_init(void)
+{
+    const pin_settings_config_t *ptr_clk = &g_pin_mux_InitConfigArr[DOX_SHIFT_SH_CP];
+    const pin_settings_config_t *ptr_data = &g_pin_mux_InitConfigArr[DOX_SHIFT_IN_DS];
+
+    mgl_shift_port = NULL;
+    if ( (ptr_clk->gpioBase != NULL) && (ptr_clk->gpioBase == ptr_data->gpioBase) &&
+         (ptr_clk->mux == PORT_MUX_AS_GPIO) && (ptr_data->mux == PORT_MUX_AS_GPIO) )
+    {
+        mgl_shift_port = ptr_clk->gpioBase;
+        mgl_shift_clk_mask = 1uL << ptr_clk->pinPortIdx;
+        mgl_shift_data_mask = 1uL << ptr_data->pinPortIdx;
+    }
+
+    mgl_shift_valid = FALSE;
+    (void)sfl_timer_set_timestamp(&mgl_shift_refresh_ts, HAL_PRECISION_1MS);
+    shift_app_update(TRUE);
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void shift_app_mark_dirty(void)
+{
+    mgl_shift_dirty = TRUE;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The image is packed and compared on every call, virtual_pin may also be written without
+* user_do_set. Packing SHIFT_OUTPUT_CHANNELS bits is cheap, the register is only shifted when the
+* image differs.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void shift_app_process(void)
+{
+    uint8_t refresh = FALSE;
+
+#if (SHIFT_APP_REFRESH_MS > 0u)
+    const uint32_t now = sfl_timer_epoch_ms();
+
+    if ((now - mgl_shift_refresh_ts) >= SHIFT_APP_REFRESH_MS)
+    {
+        mgl_shift_refresh_ts = now;
+        refresh = TRUE;
+    }
+#endif
+
+    shift_app_update(refresh);
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void shift_app_flush(void)
+{
+    if (mgl_shift_dirty == TRUE)
+    {
+        shift_app_update(FALSE);
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint32_t shift_app_get_latched(void)
+{
+    return mgl_shift_latched;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t shift_app_is_pending(void)
+{
+    return mgl_shift_dirty;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void shift_app_set_verify_cb(shift_app_verify_cb_t cb)
+{
+    mgl_shift_verify_cb = cb;
+}
@@ -0,0 +1,118 @@
+#ifndef __SHIFT_APP_H_
+#define __SHIFT_APP_H_
+/*----------------------------------------------------------------------------*/
+/**
+* \file         shift_app.h
+* \brief        Output shift register of the virtual pins
+* \details      The virtual DO pins (DOM_*, virtual_pin[0 .. SHIFT_OUTPUT_CHANNELS - 1]) are the outputs of
+*               a 74HC595 type shift register. The driver packs virtual_pin[].current_val into a 32 bit
+*               image and only shifts the register when the image differs from the latched one, instead
+*               of on every main loop iteration.
+*
+*               The clock and data lines are shifted with direct writes to the set/clear registers of
+*               their GPIO port (three stores per bit), or with hal_io_do_set if the DS places them
+*               on different ports.
+*
+*               Update latency: shift_app_process runs at the end of the main loop and compares the
+*               packed image on every call, so a change made by usercode or graphcode is on the outputs
+*               at the end of the same main loop iteration, also if it was written directly to
+*               virtual_pin. user_do_set marks the image as changed, shift_app_flush latches such a
+*               change immediately.
+*
+*               The refresh also shifts the latched image again, which repairs a register disturbed
+*               by EMC. The register has no readback line, so the verify hook gets the image which has
+*               been latched, e.g. to compare it with a diagnosis of the outputs.
+* \date         20261019
+* \author       agent
+*
+*/
+/*----------------------------------------------------------------------------*/
+
+#include "hal_data_types.h"
+#include "io_tables.h"
+#include "modulhardwarecode.h"
+
+
+// ===================================================================================================
+// Defines
+// ===================================================================================================
+#ifndef SHIFT_APP_REFRESH_MS
+#define SHIFT_APP_REFRESH_MS        (100u)      ///< period of the refresh of an unchanged image, 0 = off
+#endif
+
+#if (SHIFT_OUTPUT_CHANNELS > 32)
+#error "shift_app: the image of the shift register is limited to 32 outputs"
+#endif
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+
+/** Verify hook, called after every latch with the image of the outputs (bit k = virtual_pin[k]). */
+typedef void (*shift_app_verify_cb_t)(uint32_t image);
+
+// ===================================================================================================
+// Public function prototypes
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Prepares the port masks of the shift register lines and latches the current image.
+* \details  Called after modulhardwarecode_init, which releases the master reset of the register.
+*
+* \return   void
+*/
+void shift_app_init(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Marks the image as changed, called by user_do_set for virtual pins.
+*
+* \return   void
+*/
+void shift_app_mark_dirty(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Packs the image and shifts the register if it has changed or the refresh is due. Called in
+*           the main loop.
+*
+* \return   void
+*/
+void shift_app_process(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Latches the current image immediately, if it differs from the latched one.
+* \details  Must not be called from an interrupt.
+*
+* \return   void
+*/
+void shift_app_flush(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Returns the image which is on the outputs (bit k = virtual_pin[k]).
+*
+* \return   uint32_t
+*/
+uint32_t shift_app_get_latched(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Returns TRUE while a change made with user_do_set isn't latched yet.
+*
+* \return   uint8_t
+*/
+uint8_t shift_app_is_pending(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Registers the verify hook, NULL removes it.
+*
+* \param    cb  [in] shift_app_verify_cb_t  called in the context of shift_app_process / shift_app_flush
+* \return   void
+*/
+void shift_app_set_verify_cb(shift_app_verify_cb_t cb);
+
+#endif
@@ -0,0 +1,194 @@
+/*----------------------------------------------------------------------------*/
+/**
+ * \file         time_app.c
+ * \brief        Free-running 64 bit time base in LPIT ticks and us
+ * \details      See time_app.h
+ * \date         20261019
+ * \author       agent
+ *
+ */
+/*----------------------------------------------------------------------------*/
+#include "time_app.h"
+#include "lpit1.h"
+#include "clock_manager.h"
+#include "hal_tick.h"
+
+// ===================================================================================================
+// Global data definitions
+// ===================================================================================================
+static uint8_t mgl_time_lpit = FALSE;                               // the LPIT counts
+static uint32_t mgl_time_ticks_per_us = 1u;
+static uint8_t mgl_time_us_shift = 0u;                              // ticks per us = 2^shift, 0xFF = divide
+
+// ===================================================================================================
+// Public functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Both channels are periodic counters over the full range: TVAL 0xFFFFFFFF is a period of 2^32 ticks,
+* so the low word is simply ~CVAL, set directly since the driver takes the period in ticks - 1. The
+* channels start together.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t time_app_init(void)
+{
+    uint32_t lpit_clock = 0u;
+
+    if ( (STATUS_SUCCESS == CLOCK_SYS_GetFreq(LPIT0_CLK, &lpit_clock)) && (lpit_clock >= 1000000u) )
+    {
+        lpit_user_channel_config_t chn_cfg =
+        {
+            .timerMode = LPIT_PERIODIC_COUNTER,
+            .periodUnits = LPIT_PERIOD_UNITS_COUNTS,
+            .period = 0xFFFFFFFFuL,
+            .triggerSource = LPIT_TRIGGER_SOURCE_INTERNAL,
+            .triggerSelect = 0u,
+            .enableReloadOnTrigger = false,
+            .enableStopOnInterrupt = false,
+            .enableStartOnTrigger = false,
+            .chainChannel = false,
+            .isInterruptEnabled = false
+        };
+
+        LPIT_DRV_Init(INST_LPIT1, &lpit1_InitConfig);
+        if (STATUS_SUCCESS == LPIT_DRV_InitChannel(INST_LPIT1, TIME_APP_LPIT_CH_LO, &chn_cfg))
+        {
+            chn_cfg.chainChannel = true;
+            if (STATUS_SUCCESS == LPIT_DRV_InitChannel(INST_LPIT1, TIME_APP_LPIT_CH_HI, &chn_cfg))
+            {
+                LPIT0->TMR[TIME_APP_LPIT_CH_LO].TVAL = 0xFFFFFFFFuL;
+                LPIT0->TMR[TIME_APP_LPIT_CH_HI].TVAL = 0xFFFFFFFFuL;
+                LPIT_DRV_StartTimerChannels(INST_LPIT1, (1uL << TIME_APP_LPIT_CH_LO) | (1uL << TIME_APP_LPIT_CH_HI));
+
+                mgl_time_ticks_per_us = lpit_clock / 1000000u;
+                mgl_time_us_shift = 0xFFu;
+                for (uint8_t k = 0u; k < 32u; k++)
+                {
+                    if (mgl_time_ticks_per_us == (1uL << k))
+                    {
+                        mgl_time_us_shift = k;
+                    }
+                }
+                mgl_time_lpit = TRUE;
+            }
+        }
+    }
+
+    return mgl_time_lpit;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The high word decrements when the low one reloads. If it has changed between the two reads, the low
+* word read in between may be from before or after the reload and is read again, it is after the
+* reload then (the next one is 2^32 ticks away).
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint64_t time_app_now_ticks(void)
+{
+    uint64_t ret;
+
+    if (mgl_time_lpit == TRUE)
+    {
+        const uint32_t hi = LPIT0->TMR[TIME_APP_LPIT_CH_HI].CVAL;
+        uint32_t lo = LPIT0->TMR[TIME_APP_LPIT_CH_LO].CVAL;
+        const uint32_t hi_again = LPIT0->TMR[TIME_APP_LPIT_CH_HI].CVAL;
+
+        if (hi_again != hi)
+        {
+            lo = LPIT0->TMR[TIME_APP_LPIT_CH_LO].CVAL;
+        }
+        ret = ((uint64_t)(~hi_again) << 32) | (uint64_t)(~lo);
+    }
+    else
+    {
+        uint32_t now = 0u;
+
+        (void)hal_get_timestamp(&now, HAL_PRECISION_1US);
+        ret = now;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The ticks per us are a power of 2 with a SPLLDIV2 of 8, 16 or 32 MHz, the 64 bit division (a library
+* call on the M4) is only needed otherwise.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint64_t time_app_now_us(void)
+{
+    const uint64_t ticks = time_app_now_ticks();
+
+    return (mgl_time_us_shift != 0xFFu) ? (ticks >> mgl_time_us_shift) : (ticks / mgl_time_ticks_per_us);
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint32_t time_app_ticks32(void)
+{
+    uint32_t ret = 0u;
+
+    if (mgl_time_lpit == TRUE)
+    {
+        ret = ~LPIT0->TMR[TIME_APP_LPIT_CH_LO].CVAL;
+    }
+    else
+    {
+        (void)hal_get_timestamp(&ret, HAL_PRECISION_1US);
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint32_t time_app_ticks_to_us(uint32_t ticks)
+{
+    return ticks / mgl_time_ticks_per_us;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint32_t time_app_ticks_per_us(void)
+{
+    return mgl_time_ticks_per_us;
+}
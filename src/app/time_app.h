@@ -0,0 +1,89 @@
+#ifndef __TIME_APP_H_
+#define __TIME_APP_H_
+/*----------------------------------------------------------------------------*/
+/**
+* \file         time_app.h
+* \brief        Free-running 64 bit time base in LPIT ticks and us
+* \details      LPIT0 channel TIME_APP_LPIT_CH_LO counts down over the full 32 bit range with the LPIT
+*               clock (SPLLDIV2, a multiple of 1 MHz). Channel TIME_APP_LPIT_CH_HI is chained to it and
+*               counts its periods, together they are a 64 bit counter which doesn't wrap in the life of
+*               the module. There is no interrupt and no state in RAM: a read takes the registers
+*               (high, low, high again, the low word once more if the high one changed), so it is
+*               consistent and callable from any interrupt without locking.
+*
+*               - time_app_now_us / time_app_now_ticks:  64 bit timestamps, e.g. of an event
+*               - time_app_ticks32:                      low word only, one register read, for durations
+*                                                        up to 2^32 ticks (107 s at 40 MHz), converted
+*                                                        with time_app_ticks_to_us
+*
+*               Without the LPIT clock (time_app_init returned FALSE) the functions fall back to the
+*               32 bit us timestamp of the HAL, ticks are us then.
+* \date         20261019
+* \author       agent
+*
+*/
+/*----------------------------------------------------------------------------*/
+
+#include "hal_data_types.h"
+
+
+// ===================================================================================================
+// Defines
+// ===================================================================================================
+#define TIME_APP_LPIT_CH_LO         (0u)                ///< LPIT0 channel of the low word
+#define TIME_APP_LPIT_CH_HI         (1u)                ///< LPIT0 channel of the high word, chained to the low one
+
+// ===================================================================================================
+// Public function prototypes
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Starts the counter, before the first interrupt which takes a timestamp.
+*
+* \return   uint8_t     FALSE if the LPIT has no clock, the HAL timestamp is used then
+*/
+uint8_t time_app_init(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Ticks since time_app_init.
+*
+* \return   uint64_t
+*/
+uint64_t time_app_now_ticks(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    us since time_app_init.
+*
+* \return   uint64_t
+*/
+uint64_t time_app_now_us(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Low word of time_app_now_ticks, for the difference of two timestamps.
+*
+* \return   uint32_t
+*/
+uint32_t time_app_ticks32(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Converts a number of ticks, e.g. a difference of time_app_ticks32, into us.
+*
+* \param    ticks   [in] uint32_t
+* \return   uint32_t
+*/
+uint32_t time_app_ticks_to_us(uint32_t ticks);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Resolution of the time base.
+*
+* \return   uint32_t    ticks per us, 1 with the HAL timestamp
+*/
+uint32_t time_app_ticks_per_us(void);
+
+#endif
@@ -0,0 +1,495 @@
+/*----------------------------------------------------------------------------*/
+/**
+ * \file         timer_app.c
+ * \brief        Software timers with callbacks, one-shot and periodic
+ * \details      See timer_app.h
+ * \date         20261019
+ * \author       agent
+ *
+ */
+/*----------------------------------------------------------------------------*/
+#include "timer_app.h"
+#include "sched_app.h"
+#include "interrupt_manager.h"
+
+#define TIMER_APP_NONE              (0xFFu)             // end of a list
+#define TIMER_APP_SLOT_MASK         (TIMER_APP_WHEEL_SLOTS - 1u)
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+typedef enum
+{
+    TIMER_APP_STATE_STOPPED = 0u,
+    TIMER_APP_STATE_RUNNING,            // in the slot of its expiry
+    TIMER_APP_STATE_READY               // expired, in the ready list
+} enum_timer_app_state_t;
+
+typedef struct
+{
+    uint8_t head;
+    uint8_t tail;
+} struct_timer_app_list_t;
+
+typedef struct
+{
+    timer_app_cb_t fn;
+    void *ptr_arg;
+    uint32_t expiry;                    // ms, time of mgl_timer_ticks
+    uint32_t period_ms;                 // 0 = one-shot
+    uint8_t state;                      // enum_timer_app_state_t
+    uint8_t prev;
+    uint8_t next;
+} struct_timer_app_t;
+
+// ===================================================================================================
+// Global data definitions
+// ===================================================================================================
+static struct_timer_app_t mgl_timer[TIMER_APP_MAX];
+static uint8_t mgl_timer_cnt = 0u;
+static struct_timer_app_list_t mgl_timer_slot[TIMER_APP_WHEEL_SLOTS];
+static struct_timer_app_list_t mgl_timer_ready;
+static volatile uint32_t mgl_timer_ticks = 0u;                      // ms, counted by timer_app_tick
+static volatile uint32_t mgl_timer_due = TIMER_APP_DELAY_MAX;       // ms, no running timer expires before
+static uint32_t mgl_timer_now = 0u;                                 // ms, time of the wheel
+static struct_timer_app_stat_t mgl_timer_stat = {0u, 0u, 0u};
+
+// ===================================================================================================
+// Internal function prototypes
+// ===================================================================================================
+static void timer_app_list_push(struct_timer_app_list_t *ptr_list, uint8_t handle);
+static void timer_app_list_remove(struct_timer_app_list_t *ptr_list, uint8_t handle);
+static void timer_app_unlink(uint8_t handle);
+static void timer_app_insert(uint8_t handle);
+static void timer_app_expire(uint32_t now);
+static void timer_app_due_update(void);
+
+// ===================================================================================================
+// Functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Appends a timer at the tail.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void timer_app_list_push(struct_timer_app_list_t *ptr_list, uint8_t handle)
+{
+    struct_timer_app_t *ptr_timer = &mgl_timer[handle];
+
+    ptr_timer->prev = ptr_list->tail;
+    ptr_timer->next = TIMER_APP_NONE;
+    if (ptr_list->tail != TIMER_APP_NONE)
+    {
+        mgl_timer[ptr_list->tail].next = handle;
+    }
+    else
+    {
+        ptr_list->head = handle;
+    }
+    ptr_list->tail = handle;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void timer_app_list_remove(struct_timer_app_list_t *ptr_list, uint8_t handle)
+{
+    const struct_timer_app_t *ptr_timer = &mgl_timer[handle];
+
+    if (ptr_timer->prev != TIMER_APP_NONE)
+    {
+        mgl_timer[ptr_timer->prev].next = ptr_timer->next;
+    }
+    else
+    {
+        ptr_list->head = ptr_timer->next;
+    }
+    if (ptr_timer->next != TIMER_APP_NONE)
+    {
+        mgl_timer[ptr_timer->next].prev = ptr_timer->prev;
+    }
+    else
+    {
+        ptr_list->tail = ptr_timer->prev;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Takes a timer out of the list it is in, it is stopped afterwards.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void timer_app_unlink(uint8_t handle)
+{
+    struct_timer_app_t *ptr_timer = &mgl_timer[handle];
+
+    if (ptr_timer->state == TIMER_APP_STATE_RUNNING)
+    {
+        timer_app_list_remove(&mgl_timer_slot[ptr_timer->expiry & TIMER_APP_SLOT_MASK], handle);
+    }
+    else if (ptr_timer->state == TIMER_APP_STATE_READY)
+    {
+        timer_app_list_remove(&mgl_timer_ready, handle);
+    }
+    else
+    {
+        // not in a list
+    }
+    ptr_timer->state = TIMER_APP_STATE_STOPPED;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Puts a stopped timer with its expiry set into its slot. An earlier expiry than the one the tick waits
+* for is taken over, mgl_timer_due is one aligned word and read by the tick only.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void timer_app_insert(uint8_t handle)
+{
+    struct_timer_app_t *ptr_timer = &mgl_timer[handle];
+
+    timer_app_list_push(&mgl_timer_slot[ptr_timer->expiry & TIMER_APP_SLOT_MASK], handle);
+    ptr_timer->state = TIMER_APP_STATE_RUNNING;
+
+    if ((int32_t)(ptr_timer->expiry - mgl_timer_due) < 0)
+    {
+        mgl_timer_due = ptr_timer->expiry;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Moves the expired timers of the slot of now into the ready list. The timers of later rounds of the
+* wheel stay in the slot.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void timer_app_expire(uint32_t now)
+{
+    struct_timer_app_list_t *ptr_slot = &mgl_timer_slot[now & TIMER_APP_SLOT_MASK];
+    uint8_t handle = ptr_slot->head;
+
+    while (handle != TIMER_APP_NONE)
+    {
+        const uint8_t next = mgl_timer[handle].next;
+
+        if ((int32_t)(now - mgl_timer[handle].expiry) >= 0)
+        {
+            timer_app_list_remove(ptr_slot, handle);
+            timer_app_list_push(&mgl_timer_ready, handle);
+            mgl_timer[handle].state = TIMER_APP_STATE_READY;
+        }
+        handle = next;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Earliest expiry of the running timers, far ahead if there is none. Only when the last one has been
+* reached, a stopped timer leaves an early mgl_timer_due behind, which costs one needless event.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+static void timer_app_due_update(void)
+{
+    uint32_t due = mgl_timer_now + TIMER_APP_DELAY_MAX;
+
+    for (uint8_t k = 0u; k < mgl_timer_cnt; k++)
+    {
+        if ( (mgl_timer[k].state == TIMER_APP_STATE_RUNNING) && ((int32_t)(mgl_timer[k].expiry - due) < 0) )
+        {
+            due = mgl_timer[k].expiry;
+        }
+    }
+    mgl_timer_due = due;
+}
+
+// ===================================================================================================
+// Public functions
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The lists are set up with the first timer, before that there is nothing for them to hold.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t timer_app_create(timer_app_cb_t fn, void *ptr_arg)
+{
+    uint8_t handle = TIMER_APP_MAX;
+
+    if ( (fn != NULL) && (mgl_timer_cnt < TIMER_APP_MAX) )
+    {
+        if (mgl_timer_cnt == 0u)
+        {
+            for (uint8_t k = 0u; k < TIMER_APP_WHEEL_SLOTS; k++)
+            {
+                mgl_timer_slot[k].head = TIMER_APP_NONE;
+                mgl_timer_slot[k].tail = TIMER_APP_NONE;
+            }
+            mgl_timer_ready.head = TIMER_APP_NONE;
+            mgl_timer_ready.tail = TIMER_APP_NONE;
+            mgl_timer_now = mgl_timer_ticks;
+            mgl_timer_due = mgl_timer_now + TIMER_APP_DELAY_MAX;
+        }
+
+        handle = mgl_timer_cnt;
+        mgl_timer[handle].fn = fn;
+        mgl_timer[handle].ptr_arg = ptr_arg;
+        mgl_timer[handle].expiry = 0u;
+        mgl_timer[handle].period_ms = 0u;
+        mgl_timer[handle].state = TIMER_APP_STATE_STOPPED;
+        mgl_timer[handle].prev = TIMER_APP_NONE;
+        mgl_timer[handle].next = TIMER_APP_NONE;
+        mgl_timer_cnt++;
+    }
+
+    return handle;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The delay counts from the current ms of the tick, the wheel may not have caught up with it yet.
+* The lists are changed with the interrupts locked, so an interrupt may start a timer while the main
+* loop is in timer_app_process.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t timer_app_start(uint8_t handle, uint32_t delay_ms, uint32_t period_ms)
+{
+    uint8_t ret = FALSE;
+
+    if ( (handle < mgl_timer_cnt) && (delay_ms <= TIMER_APP_DELAY_MAX) && (period_ms <= TIMER_APP_DELAY_MAX) )
+    {
+        struct_timer_app_t *ptr_timer = &mgl_timer[handle];
+
+        INT_SYS_DisableIRQGlobal();
+        timer_app_unlink(handle);
+        ptr_timer->expiry = mgl_timer_ticks + ((delay_ms > 0u) ? delay_ms : 1u);
+        ptr_timer->period_ms = period_ms;
+        timer_app_insert(handle);
+        INT_SYS_EnableIRQGlobal();
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t timer_app_stop(uint8_t handle)
+{
+    uint8_t ret = FALSE;
+
+    if (handle < mgl_timer_cnt)
+    {
+        INT_SYS_DisableIRQGlobal();
+        timer_app_unlink(handle);
+        INT_SYS_EnableIRQGlobal();
+        ret = TRUE;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t timer_app_is_running(uint8_t handle)
+{
+    return ( (handle < mgl_timer_cnt) && (mgl_timer[handle].state != TIMER_APP_STATE_STOPPED) ) ? TRUE : FALSE;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint32_t timer_app_remaining_ms(uint8_t handle)
+{
+    uint32_t ret = 0u;
+
+    if (handle < mgl_timer_cnt)
+    {
+        INT_SYS_DisableIRQGlobal();
+        if (mgl_timer[handle].state == TIMER_APP_STATE_RUNNING)
+        {
+            const int32_t remaining = (int32_t)(mgl_timer[handle].expiry - mgl_timer_ticks);
+
+            ret = (remaining > 0) ? (uint32_t)remaining : 0u;
+        }
+        INT_SYS_EnableIRQGlobal();
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The event is posted every ms as long as mgl_timer_due is reached, until timer_app_process has taken
+* the timer and set the next one. Posting an event which is already pending costs nothing.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void timer_app_tick(void)
+{
+    const uint32_t ticks = mgl_timer_ticks + 1u;
+
+    mgl_timer_ticks = ticks;
+    if ((int32_t)(ticks - mgl_timer_due) >= 0)
+    {
+        sched_app_event_post(SCHED_EVT_TIMER);
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The wheel advances one slot per ms. After a main loop stall of more than one round only the last
+* TIMER_APP_WHEEL_SLOTS ms are walked: every slot is visited once, an expired timer is found in any
+* case, since the comparison is expiry <= now.
+*
+* A periodic timer gets its next expiry before the callback runs, so the callback may stop or restart
+* it. The periods which have passed completely are skipped.
+*
+* The lists are changed with the interrupts locked (timer_app_start / timer_app_stop may be called by
+* an interrupt), the callbacks run unlocked.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t timer_app_process(void)
+{
+    const uint32_t ticks = mgl_timer_ticks;
+    uint8_t calls = 0u;
+    uint8_t more = FALSE;
+
+    if (mgl_timer_cnt > 0u)
+    {
+        INT_SYS_DisableIRQGlobal();
+        if ((ticks - mgl_timer_now) > TIMER_APP_WHEEL_SLOTS)
+        {
+            mgl_timer_now = ticks - TIMER_APP_WHEEL_SLOTS;
+        }
+        while (mgl_timer_now != ticks)
+        {
+            mgl_timer_now++;
+            timer_app_expire(mgl_timer_now);
+        }
+        if ((int32_t)(mgl_timer_now - mgl_timer_due) >= 0)
+        {
+            timer_app_due_update();
+        }
+
+        while ( (calls < TIMER_APP_CB_PER_TICK_MAX) && (mgl_timer_ready.head != TIMER_APP_NONE) )
+        {
+            const uint8_t handle = mgl_timer_ready.head;
+            struct_timer_app_t *ptr_timer = &mgl_timer[handle];
+            const uint32_t late = mgl_timer_now - ptr_timer->expiry;
+
+            timer_app_unlink(handle);
+            if (ptr_timer->period_ms > 0u)
+            {
+                ptr_timer->expiry += ptr_timer->period_ms * ((late / ptr_timer->period_ms) + 1u);
+                timer_app_insert(handle);
+            }
+
+            mgl_timer_stat.fired++;
+            if (late > 0u)
+            {
+                mgl_timer_stat.late++;
+                if (late > mgl_timer_stat.late_max_ms)
+                {
+                    mgl_timer_stat.late_max_ms = late;
+                }
+            }
+
+            INT_SYS_EnableIRQGlobal();
+            ptr_timer->fn(handle, ptr_timer->ptr_arg);
+            calls++;
+            INT_SYS_DisableIRQGlobal();
+        }
+        more = (mgl_timer_ready.head != TIMER_APP_NONE) ? TRUE : FALSE;
+        INT_SYS_EnableIRQGlobal();
+    }
+
+    return more;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void timer_app_get_stat(struct_timer_app_stat_t *ptr_stat)
+{
+    if (ptr_stat != NULL)
+    {
+        *ptr_stat = mgl_timer_stat;
+    }
+}
@@ -0,0 +1,146 @@
+#ifndef __TIMER_APP_H_
+#define __TIMER_APP_H_
+/*----------------------------------------------------------------------------*/
+/**
+* \file         timer_app.h
+* \brief        Software timers with callbacks, one-shot and periodic
+* \details      The timers are kept in a hashed timing wheel of TIMER_APP_WHEEL_SLOTS slots of 1 ms. A
+*               running timer is in the slot (expiry % TIMER_APP_WHEEL_SLOTS), a doubly linked list, so
+*               start and stop are O(1) independent of the number of timers. Per ms one slot is checked,
+*               a timer fires when its expiry equals the time of the wheel, longer times simply pass the
+*               slot several times.
+*
+*               timer_app_tick, called in the 1 ms timer interrupt, only counts the ms. It posts
+*               SCHED_EVT_TIMER when a timer is due, timer_app_process in the main loop advances the
+*               wheel and runs the callbacks. At most TIMER_APP_CB_PER_TICK_MAX callbacks run per call,
+*               the others stay ready for the next call, so many timers expiring in the same ms don't
+*               delay the other tasks. Such a callback is late, see struct_timer_app_stat_t.
+*
+*               A periodic timer is started again before its callback runs, with the expiry advanced by
+*               the period, so it doesn't drift. Periods which have passed completely (e.g. a callback
+*               which took too long) are skipped, the callback runs once for them.
+*
+*               timer_app_start, timer_app_stop, timer_app_is_running and timer_app_remaining_ms may
+*               be called from the main loop, a callback (e.g. a timer restarting or stopping itself)
+*               and interrupts, the lists are changed with the interrupts locked. timer_app_create is
+*               for the initialisation, timer_app_process for the main loop only.
+*
+*               Example: CAN timeout of 500 ms, restarted with every message
+* \code{.c}
+*    static void timeout_cb(uint8_t handle, void *ptr_arg) { ... }
+*
+*    timeout = timer_app_create(timeout_cb, NULL);      // usercode_init
+*    (void)timer_app_start(timeout, 500u, 0u);          // message received
+* \endcode
+* \date         20261019
+* \author       agent
+*
+*/
+/*----------------------------------------------------------------------------*/
+
+#include "hal_data_types.h"
+
+
+// ===================================================================================================
+// Defines
+// ===================================================================================================
+#define TIMER_APP_MAX               (16u)               ///< timers
+#define TIMER_APP_WHEEL_SHIFT       (6u)                ///< 2^shift slots
+#define TIMER_APP_WHEEL_SLOTS       (1u << TIMER_APP_WHEEL_SHIFT)
+#ifndef TIMER_APP_CB_PER_TICK_MAX
+#define TIMER_APP_CB_PER_TICK_MAX   (4u)                ///< callbacks per call of timer_app_process
+#endif
+#define TIMER_APP_DELAY_MAX         (0x7FFFFFFFuL)      ///< ms, longest delay and period
+
+// ===================================================================================================
+// Typedef
+// ===================================================================================================
+
+/** Callback of a timer, called in the main loop. */
+typedef void (*timer_app_cb_t)(uint8_t handle, void *ptr_arg);
+
+typedef struct
+{
+    uint32_t fired;                     ///< callbacks run
+    uint32_t late;                      ///< callbacks run after the ms of their expiry
+    uint32_t late_max_ms;
+} struct_timer_app_stat_t;
+
+// ===================================================================================================
+// Public function prototypes
+// ===================================================================================================
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Creates a stopped timer.
+*
+* \param    fn      [in] timer_app_cb_t
+* \param    ptr_arg [in] void*              passed to the callback
+* \return   uint8_t                         handle 0..TIMER_APP_MAX - 1, TIMER_APP_MAX if invalid or full
+*/
+uint8_t timer_app_create(timer_app_cb_t fn, void *ptr_arg);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Starts a timer, a running one is started again.
+*
+* \param    handle      [in] uint8_t
+* \param    delay_ms    [in] uint32_t   first expiry, 1..TIMER_APP_DELAY_MAX (0 is taken as 1)
+* \param    period_ms   [in] uint32_t   0: one-shot, else the period 1..TIMER_APP_DELAY_MAX
+* \return   uint8_t                     FALSE if the handle or a time is invalid
+*/
+uint8_t timer_app_start(uint8_t handle, uint32_t delay_ms, uint32_t period_ms);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Stops a timer, its callback doesn't run any more (also if it is due already).
+*
+* \param    handle  [in] uint8_t
+* \return   uint8_t                 FALSE if the handle is invalid
+*/
+uint8_t timer_app_stop(uint8_t handle);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Checks if a timer is running.
+*
+* \param    handle  [in] uint8_t
+* \return   uint8_t                 TRUE if started and not yet expired (one-shot) or stopped
+*/
+uint8_t timer_app_is_running(uint8_t handle);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Time until a timer expires.
+*
+* \param    handle  [in] uint8_t
+* \return   uint32_t                ms, 0 if due or not running
+*/
+uint32_t timer_app_remaining_ms(uint8_t handle);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Counts one ms, called in the 1 ms timer interrupt.
+*
+* \return   void
+*/
+void timer_app_tick(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Advances the wheel to the current ms and runs up to TIMER_APP_CB_PER_TICK_MAX callbacks.
+*
+* \return   uint8_t     TRUE if callbacks are left for the next call
+*/
+uint8_t timer_app_process(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Copies the accounting of the timers.
+*
+* \param    ptr_stat    [out] struct_timer_app_stat_t*
+* \return   void
+*/
+void timer_app_get_stat(struct_timer_app_stat_t *ptr_stat);
+
+#endif
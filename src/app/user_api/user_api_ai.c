@@ -36,6 +36,7 @@ void user_ai_set_measurement_range(enum_adc_pin_name pin, uint8_t range)
 uint16_t user_ai_get(enum_adc_pin_name pin)
 {
     uint16_t ret_val = 0u;
+    adc_mux_touch(pin);
     hal_io_ai_get_digits(pin, &ret_val);
     return ret_val;
 }
@@ -80,6 +81,7 @@ uint16_t user_ai_get_cal(enum_adc_pin_name pin)
 {
 	uint16_t retval = 0u;
 
+	adc_mux_touch(pin);
 	retval = adc_results[pin].result_cal;
 
     return retval;
@@ -97,7 +99,46 @@ uint16_t user_ai_get_filtered(enum_adc_pin_name pin)
 {
     uint16_t retval = 0u;
 
+    adc_mux_touch(pin);
     retval = adc_results[pin].result_filtered;
 
     return retval;
 }
+
+/*----------------------------------------------------------------------------*/
+/**
+*  Selects the filter of result_filtered of the eligible pin (see enum_adc_pin_name)
+*
+* \internal
+* \endinternal
+*
+*/
+uint8_t user_ai_set_filter(enum_adc_pin_name pin, uint8_t type, uint8_t shift, uint8_t median)
+{
+    return adc_filter_set(pin, type, shift, median);
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+*  Returns the calibrated values of several pins of the same ADC cycle
+*
+* \internal
+* \endinternal
+*
+*/
+uint32_t user_ai_get_cal_snapshot(const enum_adc_pin_name *pins, uint16_t *values, uint8_t cnt)
+{
+    struct_adc_results_t results[USER_AI_SNAPSHOT_MAX];
+    uint32_t seq = 0u;
+
+    if ( (values != NULL) && (cnt <= USER_AI_SNAPSHOT_MAX) && adc_get_snapshot_channels(pins, cnt, results, &seq) )
+    {
+        for (uint8_t k = 0; k < cnt; k++)
+        {
+            adc_mux_touch(pins[k]);
+            values[k] = results[k].result_cal;
+        }
+    }
+
+    return seq;
+}
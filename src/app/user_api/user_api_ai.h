@@ -17,6 +17,9 @@
 #include "hal_data_types.h"
 #include "io_tables.h"
 #include "adc_app.h"
+#include "adc_filter.h"
+
+#define USER_AI_SNAPSHOT_MAX    (8u)    ///< pins of one user_ai_get_cal_snapshot() call
 
 
 /*----------------------------------------------------------------------------*/
@@ -79,6 +82,36 @@ uint16_t user_ai_get_cal(enum_adc_pin_name pin);
 */
 uint16_t user_ai_get_filtered(enum_adc_pin_name pin);
 
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Select the filter which provides user_ai_get_filtered() of an analog input.
+* \details  Default for all inputs is the filter of AD_FILTER (modulhardwarecode.h).
+*           All filters take the same time per sample, independent of the window size.
+*
+* \param    pin     [in] enum_adc_pin_name  Ports & Interfaces: Analog Input Pin
+* \param    type    [in] uint8_t            ADC_FILTER_NONE, ADC_FILTER_AVG (moving average over 2^shift samples, shift 0..4)
+*                                           or ADC_FILTER_IIR (low pass with coefficient 1/2^shift, shift 0..8)
+* \param    shift   [in] uint8_t            window or coefficient, see type
+* \param    median  [in] uint8_t            0 (off), 3 or 5: median over the last samples in front of the filter to suppress spikes
+*
+* \return   uint8_t                         TRUE if the filter has been set, FALSE for invalid parameters
+*/
+uint8_t user_ai_set_filter(enum_adc_pin_name pin, uint8_t type, uint8_t shift, uint8_t median);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Get the calibrated values of several analog inputs, all from the same ADC cycle.
+* \details  Reading the inputs one by one with user_ai_get_cal() can mix values of two cycles if an
+*           interrupt reads them. No interrupt is disabled.
+*
+* \param    pins    [in]  const enum_adc_pin_name*  Ports & Interfaces: Analog Input Pins
+* \param    values  [out] uint16_t*                 calibrated values, in the order of pins
+* \param    cnt     [in]  uint8_t                   number of pins, up to USER_AI_SNAPSHOT_MAX
+*
+* \return   uint32_t                                sequence number of the ADC cycle, 0 if no values are available
+*/
+uint32_t user_ai_get_cal_snapshot(const enum_adc_pin_name *pins, uint16_t *values, uint8_t cnt);
+
 
 #endif /* SRC_USER_API_AI_H_ */
 /** \} */
@@ -10,6 +10,7 @@
 #include "modulhardwarecode.h"
 #include "can_app.h"
 #include "sfl_bl_protocol_s32k.h"
+#include "interrupt_manager.h"
 
 // 0 < No Error. Command Succeeded.
 // 1 < Not further described error code.
@@ -30,6 +31,7 @@
 
 
 extern volatile struct_can_app_error can_error_handle[];
+extern volatile uint64_t can_rx_timestamp_us[];
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -276,6 +278,27 @@ uint8_t user_can_db_stop_gateway_for_unknown_ids(const uint8_t can_bus, const ui
     return sfl_can_db_stop_gateway_for_unknown_ids( can_bus, status );
 }
 
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* 64 bit written by the CAN interrupt, read with the interrupts disabled.
+* \endinternal
+*
+*/
+uint64_t user_can_get_rx_timestamp_us(const uint8_t can_bus)
+{
+    uint64_t timestamp = 0u;
+
+    if (can_bus < CAN_BUS_MAX)
+    {
+        INT_SYS_DisableIRQGlobal();
+        timestamp = can_rx_timestamp_us[can_bus];
+        INT_SYS_EnableIRQGlobal();
+    }
+
+    return timestamp;
+}
+
 /*----------------------------------------------------------------------------*/
 /**
 * \internal
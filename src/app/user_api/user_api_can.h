@@ -260,6 +260,17 @@ uint8_t user_can_db_stop_gateway_for_unknown_ids(const uint8_t can_bus, const ui
 **/
 void user_can_get_error(const uint8_t can_bus, struct_error_watermark* const watermark);
 
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    return the time the last CAN frame was received, e.g. to measure the latency of a response
+*           together with user_timer_get_us()
+*
+* \param    can_bus   [in] const uint8_t    CAN bus nr.
+*
+* \return   uint64_t                        us since start, 0 if nothing was received
+**/
+uint64_t user_can_get_rx_timestamp_us(const uint8_t can_bus);
+
 /*----------------------------------------------------------------------------*/
 /**
 * \brief    Set the bootloader and application baud rate. This function will set the bootloader and application baud rate
@@ -12,6 +12,7 @@
 #include "flexTimer1.h"
 #include "user_code.h"
 #include "adc_app.h"
+#include "shift_app.h"
 
 // 0 < No error.
 // 1 < Common error.
@@ -27,6 +28,9 @@
 
 extern struct_VIRTUAL_PINS_CFG virtual_pin[VIRTUAL_PIN_MAX - PIN_MAX];
 
+// GPIO registers of the ports, index enum_port_name
+static GPIO_Type * const mgl_io_port_gpio[PORT_MAX] = {PTA, PTB, PTC, PTD, PTE};
+
 /*----------------------------------------------------------------------------*/
 /**
 * \internal
@@ -46,6 +50,10 @@ void user_do_set(uint16_t pin, uint8_t state)
     {
         // Pin is a virtual DO pin
 		virtual_pin[pin - PIN_MAX].current_val = state;
+		if ( (pin - PIN_MAX) < SHIFT_OUTPUT_CHANNELS )
+		{
+			shift_app_mark_dirty();
+		}
     }
     else
     {
@@ -229,3 +237,318 @@ enum_adc_pin_name user_di_find_adc_pin(uint16_t pin)
 
     return adc_pin;
 }
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The port is found by the GPIO base of the generated pin configuration, so the map always matches the
+* pin table of the DS.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t user_io_pin_port(uint16_t pin, uint8_t *ptr_port, uint8_t *ptr_bit)
+{
+    uint8_t ret = FALSE;
+
+    if ( (pin < PIN_MAX) && (g_pin_mux_InitConfigArr[pin].mux == PORT_MUX_AS_GPIO) )
+    {
+        for (uint8_t port = 0u; port < PORT_MAX; port++)
+        {
+            if (g_pin_mux_InitConfigArr[pin].gpioBase == mgl_io_port_gpio[port])
+            {
+                *ptr_port = port;
+                *ptr_bit = (uint8_t)g_pin_mux_InitConfigArr[pin].pinPortIdx;
+                ret = TRUE;
+                break;
+            }
+        }
+    }
+
+    return ret;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t user_io_port_set_build(struct_io_port_set_t *ptr_set, const uint16_t *ptr_pins, uint8_t cnt)
+{
+    uint8_t ret = TRUE;
+    uint8_t port = 0u;
+    uint8_t bit = 0u;
+
+    for (port = 0u; port < PORT_MAX; port++)
+    {
+        ptr_set->mask[port] = 0u;
+    }
+
+    for (uint8_t k = 0u; k < cnt; k++)
+    {
+        if (user_io_pin_port(ptr_pins[k], &port, &bit) == TRUE)
+        {
+            ptr_set->mask[port] |= 1uL << bit;
+        }
+        else
+        {
+            ret = FALSE;
+        }
+    }
+
+    return ret;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void user_do_port_set(const struct_io_port_set_t *ptr_set, uint8_t state)
+{
+    for (uint8_t port = 0u; port < PORT_MAX; port++)
+    {
+        const uint32_t mask = ptr_set->mask[port];
+
+        if (mask != 0u)
+        {
+            if (state == 0u)
+            {
+                mgl_io_port_gpio[port]->PCOR = mask;
+            }
+            else
+            {
+                mgl_io_port_gpio[port]->PSOR = mask;
+            }
+        }
+    }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* hal_io_do_port_write writes the whole output register of a port, which would overwrite pins changed
+* by an interrupt in between. The set and clear registers only affect the pins of the set.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void user_do_port_write(const struct_io_port_set_t *ptr_set, const struct_io_port_set_t *ptr_state)
+{
+    for (uint8_t port = 0u; port < PORT_MAX; port++)
+    {
+        const uint32_t mask = ptr_set->mask[port];
+
+        if (mask != 0u)
+        {
+            const uint32_t high = mask & ptr_state->mask[port];
+
+            if (high != 0u)
+            {
+                mgl_io_port_gpio[port]->PSOR = high;
+            }
+            if (high != mask)
+            {
+                mgl_io_port_gpio[port]->PCOR = mask & ~high;
+            }
+        }
+    }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void user_do_port_toggle(const struct_io_port_set_t *ptr_set)
+{
+    for (uint8_t port = 0u; port < PORT_MAX; port++)
+    {
+        if (ptr_set->mask[port] != 0u)
+        {
+            mgl_io_port_gpio[port]->PTOR = ptr_set->mask[port];
+        }
+    }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void user_do_port_readback(const struct_io_port_set_t *ptr_set, struct_io_port_set_t *ptr_state)
+{
+    for (uint8_t port = 0u; port < PORT_MAX; port++)
+    {
+        uint32_t state = 0u;
+
+        if (ptr_set->mask[port] != 0u)
+        {
+            state = mgl_io_port_gpio[port]->PDOR & ptr_set->mask[port];
+        }
+        ptr_state->mask[port] = state;
+    }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void user_di_port_read(const struct_io_port_set_t *ptr_set, struct_io_port_set_t *ptr_state)
+{
+    for (uint8_t port = 0u; port < PORT_MAX; port++)
+    {
+        uint32_t state = 0u;
+
+        if (ptr_set->mask[port] != 0u)
+        {
+            (void)hal_io_di_port_read(port, &state);
+            state &= ptr_set->mask[port];
+        }
+        ptr_state->mask[port] = state;
+    }
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t user_io_port_set_get(const struct_io_port_set_t *ptr_state, uint16_t pin)
+{
+    uint8_t state = 0u;
+    uint8_t port = 0u;
+    uint8_t bit = 0u;
+
+    if (user_io_pin_port(pin, &port, &bit) == TRUE)
+    {
+        state = (uint8_t)((ptr_state->mask[port] >> bit) & 1u);
+    }
+
+    return state;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* The pins are collected per port first, so all pins of a port change with the same two stores.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint8_t user_do_pins_write(const uint16_t *ptr_pins, uint8_t cnt, uint32_t states)
+{
+    uint8_t ret = FALSE;
+    struct_io_port_set_t set;
+    struct_io_port_set_t state;
+    uint8_t port = 0u;
+    uint8_t bit = 0u;
+
+    if (cnt <= 32u)
+    {
+        ret = TRUE;
+        for (port = 0u; port < PORT_MAX; port++)
+        {
+            set.mask[port] = 0u;
+            state.mask[port] = 0u;
+        }
+
+        for (uint8_t k = 0u; k < cnt; k++)
+        {
+            if (user_io_pin_port(ptr_pins[k], &port, &bit) == TRUE)
+            {
+                set.mask[port] |= 1uL << bit;
+                state.mask[port] |= ((states >> k) & 1uL) << bit;
+            }
+            else
+            {
+                ret = FALSE;
+            }
+        }
+
+        user_do_port_write(&set, &state);
+    }
+
+    return ret;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Each port is read once, then the states are picked in the order of the list.
+* \endinternal
+*
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint32_t user_di_pins_get(const uint16_t *ptr_pins, uint8_t cnt)
+{
+    uint32_t states = 0u;
+    uint32_t port_state[PORT_MAX] = {0u};
+    uint8_t port_read = 0u;                 // bit n = port n is in port_state
+    uint8_t port = 0u;
+    uint8_t bit = 0u;
+
+    for (uint8_t k = 0u; (k < cnt) && (k < 32u); k++)
+    {
+        if (user_io_pin_port(ptr_pins[k], &port, &bit) == TRUE)
+        {
+            if ((port_read & (1u << port)) == 0u)
+            {
+                (void)hal_io_di_port_read(port, &port_state[port]);
+                port_read |= (uint8_t)(1u << port);
+            }
+            states |= ((port_state[port] >> bit) & 1uL) << k;
+        }
+    }
+
+    return states;
+}
@@ -13,6 +13,8 @@
 * \brief        This handles the IO functionality
 * \details      All functions for working with IO are listed here. Functions to configure, read status and set the IO pins.
 *               Pay attention to the configuration of PINS. Some pins could be preconfigured with pwm functionality and may need to be reconfigured.
+*               Groups of GPIO pins can be written and sampled port by port with a struct_io_port_set_t, e.g. the
+*               mux lines or the enables of the CAN transceivers with one set or clear per port.
 *
 */
 /*----------------------------------------------------------------------------*/
@@ -64,5 +66,130 @@ uint8_t user_di_get(uint16_t pin);
 */
 enum_adc_pin_name user_di_find_adc_pin(uint16_t pin);
 
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Pins of several ports, bit n of mask[port] is pin n of the port (enum_port_name).
+* \details  Built once with user_io_port_set_build, then a whole group of pins is written or sampled with
+*           one register access per port instead of one HAL call per pin. The same type holds the sampled
+*           or requested states of the pins.
+*/
+typedef struct
+{
+    uint32_t mask[PORT_MAX];
+} struct_io_port_set_t;
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Port and port pin of a GPIO pin
+* \details  The map follows the pin configuration generated by the DS (g_pin_mux_InitConfigArr), virtual,
+*           PWM and ADC pins aren't in it.
+*
+* \param    pin       [in]  uint16_t   Ports & Interfaces: pin
+* \param    ptr_port  [out] uint8_t*   enum_port_name
+* \param    ptr_bit   [out] uint8_t*   pin of the port 0..31
+*
+* \return   uint8_t                     FALSE if the pin isn't configured as GPIO
+*/
+uint8_t user_io_pin_port(uint16_t pin, uint8_t *ptr_port, uint8_t *ptr_bit);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Build a port set from a list of pins
+*
+* \param    ptr_set   [out] struct_io_port_set_t*
+* \param    ptr_pins  [in]  const uint16_t*         Ports & Interfaces: pins
+* \param    cnt       [in]  uint8_t                 number of pins
+*
+* \return   uint8_t                                 FALSE if a pin isn't configured as GPIO, the other pins are added
+*/
+uint8_t user_io_port_set_build(struct_io_port_set_t *ptr_set, const uint16_t *ptr_pins, uint8_t cnt);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Set or clear all digital output pins of a set, one store to PSOR or PCOR per port
+*
+* \param    ptr_set   [in] const struct_io_port_set_t*
+* \param    state     [in] uint8_t                     Boolean
+*
+*/
+void user_do_port_set(const struct_io_port_set_t *ptr_set, uint8_t state);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Write the digital output pins of a set to individual states
+* \details  Per port the pins to be set are written to PSOR and the pins to be cleared to PCOR. Each store
+*           is atomic, other pins of the port (also changed by interrupts) are not affected.
+*
+* \param    ptr_set   [in] const struct_io_port_set_t*   pins to be written
+* \param    ptr_state [in] const struct_io_port_set_t*   states, bits outside of ptr_set are ignored
+*
+*/
+void user_do_port_write(const struct_io_port_set_t *ptr_set, const struct_io_port_set_t *ptr_state);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Toggle all digital output pins of a set, one store to PTOR per port
+*
+* \param    ptr_set   [in] const struct_io_port_set_t*
+*
+*/
+void user_do_port_toggle(const struct_io_port_set_t *ptr_set);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Read back the output states of the digital output pins of a set
+*
+* \param    ptr_set   [in]  const struct_io_port_set_t*
+* \param    ptr_state [out] struct_io_port_set_t*         states, bits outside of ptr_set are 0
+*
+*/
+void user_do_port_readback(const struct_io_port_set_t *ptr_set, struct_io_port_set_t *ptr_state);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Sample the digital input pins of a set, one read of the port per port with pins in the set
+*
+* \param    ptr_set   [in]  const struct_io_port_set_t*
+* \param    ptr_state [out] struct_io_port_set_t*         states, bits outside of ptr_set are 0
+*
+*/
+void user_di_port_read(const struct_io_port_set_t *ptr_set, struct_io_port_set_t *ptr_state);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    State of one pin in the states of a port set
+*
+* \param    ptr_state [in] const struct_io_port_set_t*    returned by user_di_port_read / user_do_port_readback
+* \param    pin       [in] uint16_t                       Ports & Interfaces: pin
+*
+* \return   uint8_t                                       state of the pin, 0 if it isn't a GPIO pin
+*/
+uint8_t user_io_port_set_get(const struct_io_port_set_t *ptr_state, uint16_t pin);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Write a list of digital output pins, bit k of states is the state of ptr_pins[k]
+* \details  For lists which change at runtime, fixed groups are faster with a prebuilt set and
+*           user_do_port_write.
+*
+* \param    ptr_pins  [in] const uint16_t*     Ports & Interfaces: digital output pins, GPIO only
+* \param    cnt       [in] uint8_t             number of pins, max. 32
+* \param    states    [in] uint32_t
+*
+* \return   uint8_t                             FALSE if a pin isn't configured as GPIO or cnt is too high
+*/
+uint8_t user_do_pins_write(const uint16_t *ptr_pins, uint8_t cnt, uint32_t states);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Sample a list of digital input pins, bit k of the result is the state of ptr_pins[k]
+*
+* \param    ptr_pins  [in] const uint16_t*     Ports & Interfaces: digital input pins, GPIO only
+* \param    cnt       [in] uint8_t             number of pins, max. 32
+*
+* \return   uint32_t                            states, 0 for pins which aren't configured as GPIO
+*/
+uint32_t user_di_pins_get(const uint16_t *ptr_pins, uint8_t cnt);
+
 /** \} */
 #endif /* SRC_USER_API_IO_H_ */
@@ -129,7 +129,12 @@ uint32_t user_pwm_set_dither(uint16_t pin, uint16_t duty, uint16_t freq, uint16_
 {
 	uint32_t ret_val = 0;
 
-    if (pin < PWM_MAX)
+    if ( (pin < PWM_MAX) && (duty > 1000) )
+    {
+        // the limits of the dither duty below are only valid up to 1000 promille
+        ret_val = (uint32_t)HAL_PWM_ERROR_GENERAL;
+    }
+    else if (pin < PWM_MAX)
     {
         // Validate dither duty will not be bigger/smaller then max/min duty possible
         if (dither_duty > duty )
@@ -178,6 +183,9 @@ uint32_t user_pwm_set_dither(uint16_t pin, uint16_t duty, uint16_t freq, uint16_
             pwm_vals_t[pin].duty_cycle = duty;
         }
         ret_val = user_set_pwm_duty(pin, duty);
+
+        // dither list of the FTM module and compare values for the overflow interrupt
+        ftm_dither_update((uint8_t)pin);
     }
 
     return ret_val;
@@ -149,7 +149,7 @@ uint32_t user_pwm_output_force(uint16_t pin, uint16_t forced_output_value);
 * \pre
 *
 * \param    pin         [in] uint16_t	PWM pin name from struct_FTM_CONFIG inside io_tables.c
-* \param    duty        [in] uint16_t	Duty cycle of the PWM signal
+* \param    duty        [in] uint16_t	Duty cycle of the PWM signal, 0..1000 promille
 * \param    freq        [in] uint16_t	Frequency of the PWM signal
 * \param    dither_duty [in] uint16_t	Duty Cycle of the dither, will be periodically added/subtracted from the duty cycle
 * \param    dither_freq [in] uint16_t	Frequency of the dither from which the periods of the dither will be calculated
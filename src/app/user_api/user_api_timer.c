@@ -7,6 +7,8 @@
 
 #include "user_api_timer.h"
 #include "sfl_timer.h"
+#include "timer_app.h"
+#include "time_app.h"
 
 // 0 < no error
 // 1 < presicion invalid
@@ -34,7 +36,8 @@ enum_SFL_TIMER_ERR user_set_timestamp(uint32_t *timestamp, enum_PRECISION precis
 */
 uint8_t user_time_past(uint32_t timestamp_t0, uint32_t span, enum_PRECISION precision)
 {
-    static uint8_t elapsed = 0;
+    // local, a static result would be shared by all timeouts of the application
+    uint8_t elapsed = FALSE;
 
     (void)sfl_timer_time_elapsed(&elapsed, timestamp_t0, span, precision);
 
@@ -51,10 +54,76 @@ uint8_t user_time_past(uint32_t timestamp_t0, uint32_t span, enum_PRECISION prec
 */
 enum_SFL_TIMER_ERR user_get_roundtrip_time(uint32_t *roundtrip_time, enum_PRECISION precision, uint8_t reset_start)
 {
-    return sfl_timer_get_roundtrip_time(roundtrip_time, precision);
-
+    // the reset has to come first, after the return it was never done
     if(reset_start)
     {
         sfl_timer_init();
     }
+
+    return sfl_timer_get_roundtrip_time(roundtrip_time, precision);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*
+* \endinternal
+*
+*/
+uint8_t user_timer_create(user_timer_cb_t fn, void* ptr_arg)
+{
+    return timer_app_create(fn, ptr_arg);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*
+* \endinternal
+*
+*/
+uint8_t user_timer_start(uint8_t handle, uint32_t delay_ms, uint32_t period_ms)
+{
+    return timer_app_start(handle, delay_ms, period_ms);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*
+* \endinternal
+*
+*/
+uint8_t user_timer_stop(uint8_t handle)
+{
+    return timer_app_stop(handle);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*
+* \endinternal
+*
+*/
+uint8_t user_timer_is_running(uint8_t handle)
+{
+    return timer_app_is_running(handle);
+}
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*
+* \endinternal
+*
+*/
+uint64_t user_timer_get_us(void)
+{
+    return time_app_now_us();
 }
@@ -73,5 +73,68 @@ uint8_t user_get_roundtrip_time(uint32_t* roundtrip_time, enum_PRECISION precisi
 #define user_timer_get_prog_cycletime( roundtrip_time, precision,reset_start ) user_get_roundtrip_time( roundtrip_time, precision,reset_start )
 
 
+/** Callback of a software timer, runs in the main loop (not in an interrupt). */
+typedef void (*user_timer_cb_t)(uint8_t handle, void* ptr_arg);
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Create a software timer with a callback, e.g. in usercode_init(). It is stopped until started.
+*
+* \param    fn      [in] user_timer_cb_t    Function called when the timer expires
+* \param    ptr_arg [in] void*              Passed to the callback
+*
+* \return   uint8_t                         Handle of the timer, 16 (no timer left) if it failed
+*/
+uint8_t user_timer_create(user_timer_cb_t fn, void* ptr_arg);
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Start or restart a software timer. Replaces a timestamp polled with user_time_past().
+*           Can also be called in interrupts.
+*
+* \param    handle    [in] uint8_t    Handle of user_timer_create()
+* \param    delay_ms  [in] uint32_t   Time until the first call of the callback in ms
+* \param    period_ms [in] uint32_t   0: called once, else called again every period_ms
+*
+* \return   uint8_t                   1 if started, 0 if the handle is invalid
+*/
+uint8_t user_timer_start(uint8_t handle, uint32_t delay_ms, uint32_t period_ms);
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Stop a software timer, its callback is not called any more. Can also be called in interrupts.
+*
+* \param    handle [in] uint8_t   Handle of user_timer_create()
+*
+* \return   uint8_t               1 if stopped, 0 if the handle is invalid
+*/
+uint8_t user_timer_stop(uint8_t handle);
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Check whether a software timer is running
+*
+* \param    handle [in] uint8_t   Handle of user_timer_create()
+*
+* \return   uint8_t               1 if running, 0 if stopped, expired (called once) or invalid
+*/
+uint8_t user_timer_is_running(uint8_t handle);
+
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Time since start in us, 64 bit (doesn't overflow). Can also be called in interrupts.
+*           Differences of two values measure short times, e.g. the latency of a CAN response.
+*
+* \return   uint64_t                    us since start
+*/
+uint64_t user_timer_get_us(void);
+
+
+
 #endif /* SRC_USER_API_TIMER_H_ */
 /** \} */
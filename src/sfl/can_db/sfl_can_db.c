@@ -33,6 +33,9 @@ extern volatile const can_bus_db_const_typ can_bus_db_const[];
 
 static callback_can_msg_receive_t callback_can_msg_receive = NULL_PTR;
 
+// number of frames dropped because the rx [0] or tx [1] fifo of a bus was full
+static uint32_t mgl_can_fifo_overflow_cnt[CAN_BUS_MAX][2] = {{0u}};
+
 
 
 /*----------------------------------------------------------------------------*/
@@ -438,9 +441,11 @@ void sfl_can_db_rx_wrapper(const uint8_t p_bus_id, const struct_hal_can_frame* c
     retval = sfl_fifo_put( can_fifo_config_actual[p_bus_id]->rx_fifo_config, (uint8_t*) &l_can_msg, (uint8_t*) can_fifo_config_actual[p_bus_id]->ptr_rx_fifo_buffer);
     if(retval != SFL_FIFO_ERROR_NONE)
 	{
-        // fifo full
-        //  @TODO CAN ERROR WATERMARK
-
+        // fifo full, frame is lost
+        if (p_bus_id < CAN_BUS_MAX)
+        {
+            mgl_can_fifo_overflow_cnt[p_bus_id][0]++;
+        }
     }
 
     (void)sfl_bl_protocol_s32k_process_rx_msg(ptr_can_msg);
@@ -517,7 +522,10 @@ enum_HAL_CAN_RETURN_VALUE sfl_can_db_tx_wrapper(const uint8_t p_bus_id, const bi
     if ( retval != SFL_FIFO_ERROR_NONE )
     {   //fifo full or busy
         error = HAL_CAN_ERROR_WHILE_WRITING;
-        //  @TODO CAN ERROR WATERMARK
+        if (p_bus_id < CAN_BUS_MAX)
+        {
+            mgl_can_fifo_overflow_cnt[p_bus_id][1]++;
+        }
     }
     else
     {
@@ -643,7 +651,7 @@ void sfl_can_input_block_to_db(const uint8_t bus_id, bios_can_msg_typ* const msg
                         }
                         else
                         {
-                            sfl_timer_set_timestamp(&can_block_db_ram[i].time_stamp_read, HAL_PRECISION_1MS);
+                            can_block_db_ram[i].time_stamp_read = sfl_timer_now_ms();
                             can_block_db_ram[i].received = 1;
                         }
                         // copy data of message to local buffer
@@ -696,13 +704,16 @@ void sfl_can_input_block_to_db(const uint8_t bus_id, bios_can_msg_typ* const msg
  *   Date       | Type    | Person
  *   -----------|---------|-----------
  *   20160823   | Author  | riegel
+ *   20261019   | Changed | agent
  */
 
 void sfl_can_db_output_to_bus( void )
 {
 
     uint16_t d, flag_senden;
-    uint8_t dlc, t_elapsed;
+    uint8_t dlc;
+    // one time for all blocks of this pass, the comparisons are right across the timer overflow
+    const uint32_t now = sfl_timer_epoch_ms();
 
     // Werte in Bloecke eintragen
     for (uint32_t counter = 0; counter < dyn_CAN_BLOCK_MAX; (counter)++)
@@ -718,22 +729,20 @@ void sfl_can_db_output_to_bus( void )
             if (can_block_db_ram[counter].transmit == 1)
 			{
                 // Sende anforderungen unter 10ms werden blockiert
-                if (sfl_timer_time_elapsed(&t_elapsed, can_block_db_ram[counter].time_stamp_transmit, 10, HAL_PRECISION_1MS) == SFL_TIMER_ERR_OK && t_elapsed == TRUE)
+                if (sfl_timer_is_elapsed(can_block_db_ram[counter].time_stamp_transmit, 10u, now) == TRUE)
                 {
-                    sfl_timer_set_timestamp(&can_block_db_ram[counter].time_stamp_transmit, HAL_PRECISION_1MS);
+                    can_block_db_ram[counter].time_stamp_transmit = now;
                     flag_senden = 1; // Programm/Userbefehl die Nachricht zusenden.
                 }
             }
 // Wenn Zykluszeit ueberschritten sende sofort
             if (can_block_db_const[counter].zykluszeit_ms_max || flag_senden == 1) // Wenn die zykluszeit_max = 0 ist, dann nie senden.
             {
-                if (sfl_timer_time_elapsed(&t_elapsed, can_block_db_ram[counter].time_stamp_write, can_block_db_const[counter].zykluszeit_ms_max, HAL_PRECISION_1MS)
-                        == SFL_TIMER_ERR_OK&& t_elapsed == TRUE)
+                if (sfl_timer_is_elapsed(can_block_db_ram[counter].time_stamp_write, can_block_db_const[counter].zykluszeit_ms_max, now) == TRUE)
                 {
                     flag_senden = 1; // Wenn die zykluszeit_max ueberschritten ist, dann senden.
                 }
-                else if (sfl_timer_time_elapsed(&t_elapsed, can_block_db_ram[counter].time_stamp_write, can_block_db_const[counter].zykluszeit_ms_min, HAL_PRECISION_1MS)
-                        == SFL_TIMER_ERR_OK&& t_elapsed == TRUE)
+                else if (sfl_timer_is_elapsed(can_block_db_ram[counter].time_stamp_write, can_block_db_const[counter].zykluszeit_ms_min, now) == TRUE)
                 {
                     // do not send if data is the same as last data
                     // @TODO: does not work eventually with can-fd
@@ -769,7 +778,7 @@ void sfl_can_db_output_to_bus( void )
                         }
 
                         // we only update the timestamp if the send was successful.
-                        sfl_timer_set_timestamp(&can_block_db_ram[counter].time_stamp_write, HAL_PRECISION_1MS);
+                        can_block_db_ram[counter].time_stamp_write = now;
                     }
                     else
                     {
@@ -1072,6 +1081,35 @@ enum_HAL_CAN_RETURN_VALUE sfl_can_send_message(const struct_hal_can_handle* ptr_
 }
 
 
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Counters are only incremented, the caller builds differences to get a rate.
+* \endinternal
+*
+*
+* \test STATUS: *** UNTESTED ***
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint32_t sfl_can_db_get_fifo_overflow_count(const uint8_t bus_id, const uint8_t tx_or_rx)
+{
+    uint32_t ret_val = 0u;
+
+    if ( (bus_id < CAN_BUS_MAX) && (tx_or_rx < 2u) )
+    {
+        ret_val = mgl_can_fifo_overflow_cnt[bus_id][tx_or_rx];
+    }
+    else
+    {
+        // do nothing, bus not existent or tx_or_rx out of bounds
+    }
+
+    return ret_val;
+}
+
+
 /*----------------------------------------------------------------------------*/
 /**
 * \internal
@@ -449,6 +449,19 @@ enum_HAL_CAN_RETURN_VALUE sfl_can_send_message(const struct_hal_can_handle* ptr_
 */
 void set_callback_can_msg_receive(callback_can_msg_receive_t callback);
 
+/*----------------------------------------------------------------------------*/
+/**
+* \ingroup
+* \brief    Returns the number of CAN frames lost because the RX or TX FIFO of the given bus was full.
+* \details  The RX counter is incremented in #sfl_can_db_rx_wrapper, the TX counter in #sfl_can_db_tx_wrapper.
+*           Use it to size CANx_RX_FIFO_SIZE / CANx_TX_FIFO_SIZE in can_db_tables.h.
+*
+* \param    bus_id   [in] const uint8_t   CAN bus nr
+* \param    tx_or_rx [in] const uint8_t   0 for the RX FIFO and 1 for the TX FIFO, same as #sfl_can_db_get_fifo_size
+* \return   uint32_t                      number of dropped frames since start, 0 for an invalid bus
+*/
+uint32_t sfl_can_db_get_fifo_overflow_count(const uint8_t bus_id, const uint8_t tx_or_rx);
+
 
 #endif
 
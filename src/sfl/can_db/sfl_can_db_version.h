@@ -20,8 +20,11 @@
 *                  |   -> it is backwards compatible due to wrapper
 *                  | - added function sfl_can_db_stop_gateway_for_known_ids (refer commentary of function)
 *                  | - added function sfl_can_db_stop_gateway_for_unknown_ids (refer commentary of function)
+*                3 | - added function sfl_can_db_get_fifo_overflow_count, counts frames lost on full RX/TX FIFOs
+*                4 | - sfl_can_db_output_to_bus compares the send times with the main loop epoch modulo 2^32,
+*                  |   the cyclic send no longer stops after the 49.7 day overflow of the ms timestamp
 */
-#define SFL_CAN_DB_VERSION   2u   ///< Version Number (integer) for MRS can db functionality
+#define SFL_CAN_DB_VERSION   4u   ///< Version Number (integer) for MRS can db functionality
 
 /** \} */
 #endif // SFL_CAN_DB_VERSION_H
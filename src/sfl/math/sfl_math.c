@@ -24,6 +24,14 @@
 // module globals
 // ---------------------------------------------------------------------------------------------------
 
+// ---------------------------------------------------------------------------------------------------
+// internal function prototypes
+// ---------------------------------------------------------------------------------------------------
+static uint16_t sfl_math_lower_bound16(const int16_t *table, uint16_t lo, uint16_t hi, int16_t val);
+static uint16_t sfl_math_upper_bound16(const int16_t *table, uint16_t lo, uint16_t hi, int16_t val);
+static uint16_t sfl_math_upper_bound32(const int32_t *table, uint16_t lo, uint16_t hi, int32_t val);
+static int16_t  sfl_math_limit16(int32_t val, enum_LUT_MODE mode);
+
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -528,4 +536,438 @@ int32_t os_util_lookup2D_32(int32_t *table_x, int32_t *table_y, uint8_t count_x,
     return z;
 }
 
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*   First index in [lo, hi) with table[i] >= val, hi if there is none. table is ascending.
+* \endinternal
+*/
+static uint16_t sfl_math_lower_bound16(const int16_t *table, uint16_t lo, uint16_t hi, int16_t val)
+{
+    const int16_t *base = &table[lo];
+    uint16_t len = hi - lo;
+    uint16_t half;
+
+    if( len == 0u )
+    {
+        return hi;
+    }
+
+    // The result is in [base, base + len]. The compare selects the half without a branch, so the run time
+    // only depends on the table size.
+    while( len > 1u )
+    {
+        half = len >> 1u;
+        base = (base[half] < val) ? &base[half] : base;
+        len -= half;
+    }
+
+    return (uint16_t)((base - table) + ((*base < val) ? 1 : 0));
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*   First index in [lo, hi) with val < table[i], hi if there is none. table is ascending.
+* \endinternal
+*/
+static uint16_t sfl_math_upper_bound16(const int16_t *table, uint16_t lo, uint16_t hi, int16_t val)
+{
+    const int16_t *base = &table[lo];
+    uint16_t len = hi - lo;
+    uint16_t half;
+
+    if( len == 0u )
+    {
+        return hi;
+    }
+
+    // Branch free halving, see sfl_math_lower_bound16()
+    while( len > 1u )
+    {
+        half = len >> 1u;
+        base = (val < base[half]) ? base : &base[half];
+        len -= half;
+    }
+
+    return (uint16_t)((base - table) + ((val < *base) ? 0 : 1));
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*   32 bit version of sfl_math_upper_bound16().
+* \endinternal
+*/
+static uint16_t sfl_math_upper_bound32(const int32_t *table, uint16_t lo, uint16_t hi, int32_t val)
+{
+    const int32_t *base = &table[lo];
+    uint16_t len = hi - lo;
+    uint16_t half;
+
+    if( len == 0u )
+    {
+        return hi;
+    }
+
+    // Branch free halving, see sfl_math_lower_bound16()
+    while( len > 1u )
+    {
+        half = len >> 1u;
+        base = (val < base[half]) ? base : &base[half];
+        len -= half;
+    }
+
+    return (uint16_t)((base - table) + ((val < *base) ? 0 : 1));
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*   Limits a result to the int16 range and to >= 0 for LUT_MODE_CALIBRATION and LUT_MODE_EXTRAPOLATION_POS.
+* \endinternal
+*/
+static int16_t sfl_math_limit16(int32_t val, enum_LUT_MODE mode)
+{
+    if( val > NR_MAX_INT16 )
+    {
+        val = NR_MAX_INT16;
+    }
+    else if( val < NR_MIN_INT16 )
+    {
+        val = NR_MIN_INT16;
+    }
+    else
+    {
+        // do nothing
+    }
+
+    if( ((mode == LUT_MODE_CALIBRATION) || (mode == LUT_MODE_EXTRAPOLATION_POS)) && (val < 0L) )
+    {
+        val = 0L;
+    }
+    else
+    {
+        // do nothing
+    }
+
+    return (int16_t)val;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*   Same calculation as os_util_lookup1D(): the lower bound of val_x in table_x[1..count-1] is the upper point
+*   of the segment, which is the same point as the linear scan finds.
+* \endinternal
+*/
+int16_t os_util_lookup1D_bsearch(const int16_t *table_x, const int16_t *table_y, uint16_t count_points, int16_t val_x, enum_LUT_MODE mode)
+{
+    uint16_t    i, k;
+    int32_t     dy;
+    int32_t     dx;
+    int32_t     ret = 0L;
+    int16_t     x2;
+    int16_t     y2;
+
+    if( (2u <= count_points) && ((LUT_MODE_MAX) > mode) )
+    {
+        if( val_x > table_x[count_points - 1u] )
+        {
+            // Extrapolate upwards with the last two points.
+            k  = count_points - 2u;
+            x2 = table_x[count_points - 1u];
+            y2 = table_y[count_points - 1u];
+
+            if( mode == LUT_MODE_CALIBRATION )
+            {
+                // Keep the difference x-y of the point (see os_util_lookup1D)
+                return sfl_math_limit16((int32_t)val_x - ((int32_t)table_x[k] - table_y[k]), mode);
+            }
+        }
+        else
+        {
+            i  = sfl_math_lower_bound16(table_x, 1u, count_points, val_x);
+            k  = i - 1u;
+            x2 = table_x[i];
+            y2 = table_y[i];
+
+            if( val_x < table_x[0] )
+            {
+                if( mode == LUT_MODE_LIMIT )
+                {
+                    return sfl_math_limit16(table_y[0], mode);
+                }
+
+                // Extrapolate downwards from the first point.
+                x2 = table_x[0];
+                y2 = table_y[0];
+            }
+        }
+
+        dx  = (int32_t)x2 - val_x;
+        dy  = (int32_t)(table_y[k + 1u] - table_y[k]) * dx;
+        dy /= (int32_t)(table_x[k + 1u] - table_x[k]);
+        ret = sfl_math_limit16((int32_t)y2 - dy, mode);
+    }
+
+    return (int16_t)ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*   Same calculation as os_util_lookup1D_32(), the segment is the upper bound of val in table_x[1..count-1].
+* \endinternal
+*/
+int32_t os_util_lookup1D_32_bsearch(const int32_t *table_x, const int32_t *table_y, uint16_t count, int32_t val, enum_LUT_MODE mode)
+{
+    uint16_t k;
+    int32_t m, b;
+    int32_t ret = 0;
+    uint8_t val_inside = 0;
+
+    if( (count < 2u) || (mode >= LUT_MODE_MAX) )
+    {
+        return 0;
+    }
+
+    // Extrapolate downwards?
+    if( val <= table_x[0] )
+    {
+        k = 0;
+    }
+    // Extrapolate upwards?
+    else if( val >= table_x[count - 1u] )
+    {
+        k = ( (mode == LUT_MODE_EXTRAPOLATION) || (mode == LUT_MODE_EXTRAPOLATION_POS) ) ? (count - 2u) : (count - 1u);
+
+        if( mode == LUT_MODE_CALIBRATION )
+        {
+            ret = val - (table_x[k] - table_y[k]);
+            val_inside = 2;
+        }
+    }
+    else
+    {
+        k = sfl_math_upper_bound32(table_x, 1u, count - 1u, val) - 1u;
+        val_inside = 1;
+    }
+
+    if( (mode == LUT_MODE_LIMIT) && (val_inside == 0) )
+    {
+        ret = table_y[k];
+    }
+    else if( val_inside != 2 )
+    {
+        m = ((table_y[k+1] - table_y[k]) * 1000L) / (table_x[k+1] - table_x[k]);
+        b = table_y[k] - ((m * table_x[k]) / 1000L);
+        ret = (m * val) / 1000L + b;
+    }
+    else
+    {
+        // do nothing
+    }
+
+    if( ((mode == LUT_MODE_CALIBRATION) || (mode == LUT_MODE_EXTRAPOLATION_POS)) && (ret < 0) )
+    {
+        ret = 0;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*   y = y[k] + ((y[k+1] - y[k]) * (val_x - x[k])) >> x_shift, with k = (val_x - x0) >> x_shift limited to the
+*   first or last segment for extrapolation.
+* \endinternal
+*/
+int16_t os_util_lookup1D_uniform(const int16_t *table_y, uint16_t count, int16_t x0, uint8_t x_shift, int16_t val_x, enum_LUT_MODE mode)
+{
+    int32_t pos;
+    int32_t k;
+    int32_t ret = 0L;
+
+    if( (2u <= count) && ((LUT_MODE_MAX) > mode) && (x_shift <= 14u) )
+    {
+        pos = (int32_t)val_x - x0;
+        k   = pos >> x_shift;
+
+        if( k < 0L )
+        {
+            k = 0L;
+            if( mode == LUT_MODE_LIMIT )
+            {
+                return sfl_math_limit16(table_y[0], mode);
+            }
+        }
+        else if( k > (int32_t)(count - 2u) )
+        {
+            if( (mode == LUT_MODE_LIMIT) && (pos >= ((int32_t)(count - 1u) << x_shift)) )
+            {
+                return sfl_math_limit16(table_y[count - 1u], mode);
+            }
+            k = (int32_t)count - 2L;
+            if( (mode == LUT_MODE_CALIBRATION) && (pos > ((int32_t)(count - 1u) << x_shift)) )
+            {
+                // Keep the difference x-y of the point (see os_util_lookup1D)
+                return sfl_math_limit16((int32_t)val_x - ((int32_t)x0 + (k << x_shift) - table_y[k]), mode);
+            }
+        }
+        else
+        {
+            // do nothing
+        }
+
+        pos -= (k << x_shift);
+        ret  = table_y[k] + (int32_t)(((int64_t)(table_y[k + 1] - table_y[k]) * pos) >> x_shift);
+        ret  = sfl_math_limit16(ret, mode);
+    }
+
+    return (int16_t)ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*/
+uint8_t os_util_lut1D_prepare(struct_lut1D *lut, const int16_t *table_x, const int16_t *table_y, uint16_t count, int32_t *slope)
+{
+    uint8_t ret = TRUE;
+    uint16_t i;
+    int32_t dx, dy;
+
+    lut->count = 0u;
+
+    if( (count < 2u) || (table_x == NULL) || (table_y == NULL) || (slope == NULL) )
+    {
+        ret = FALSE;
+    }
+
+    for( i = 0u; (ret == TRUE) && (i < (count - 1u)); i++ )
+    {
+        dx = (int32_t)table_x[i + 1u] - table_x[i];
+        dy = (int32_t)table_y[i + 1u] - table_y[i];
+
+        if( (dx <= 0L) || (dy > (NR_MAX_INT16 * dx)) || (dy < (-NR_MAX_INT16 * dx)) )
+        {
+            ret = FALSE;
+        }
+        else
+        {
+            slope[i] = (int32_t)(((int64_t)dy * 65536L) / dx);
+        }
+    }
+
+    if( ret == TRUE )
+    {
+        lut->table_x = table_x;
+        lut->table_y = table_y;
+        lut->slope   = slope;
+        lut->count   = count;
+    }
+
+    return ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*   y = y[k] + (slope[k] * (val_x - x[k])) >> 16
+* \endinternal
+*/
+int16_t os_util_lut1D(const struct_lut1D *lut, int16_t val_x, enum_LUT_MODE mode)
+{
+    const uint16_t count = lut->count;
+    uint16_t k;
+    int32_t ret = 0L;
+
+    if( (2u <= count) && ((LUT_MODE_MAX) > mode) )
+    {
+        if( val_x < lut->table_x[0] )
+        {
+            if( mode == LUT_MODE_LIMIT )
+            {
+                return sfl_math_limit16(lut->table_y[0], mode);
+            }
+            k = 0u;
+        }
+        else if( val_x > lut->table_x[count - 1u] )
+        {
+            k = count - 2u;
+            if( mode == LUT_MODE_LIMIT )
+            {
+                return sfl_math_limit16(lut->table_y[count - 1u], mode);
+            }
+            if( mode == LUT_MODE_CALIBRATION )
+            {
+                // Keep the difference x-y of the point (see os_util_lookup1D)
+                return sfl_math_limit16((int32_t)val_x - ((int32_t)lut->table_x[k] - lut->table_y[k]), mode);
+            }
+        }
+        else
+        {
+            k = sfl_math_upper_bound16(lut->table_x, 1u, count - 1u, val_x) - 1u;
+        }
+
+        ret = lut->table_y[k] + (int32_t)(((int64_t)lut->slope[k] * ((int32_t)val_x - lut->table_x[k])) >> 16);
+        ret = sfl_math_limit16(ret, mode);
+    }
+
+    return (int16_t)ret;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+*   Same calculation as os_util_lookup2D(), only the segment search differs.
+* \endinternal
+*/
+int16_t os_util_lookup2D_bsearch(const int16_t *table_x, const int16_t *table_y, uint8_t count_x, uint8_t count_y, const int16_t *table_z, int16_t val_x, int16_t val_y)
+{
+    uint8_t x,y,x_1,y_1,y_raw;
+    int32_t m1,m2,m3, b1,b2,b3, z1,z2,z;
+
+    // 1. + 2. Segments of both axes, the last one by default
+    x     = (uint8_t)(sfl_math_upper_bound16(table_x, 1u, count_x - 1u, val_x) - 1u);
+    y_raw = (uint8_t)(sfl_math_upper_bound16(table_y, 1u, count_y - 1u, val_y) - 1u);
+    y     = y_raw * count_x;
+
+    x_1 = x + 1;
+    y_1 = y + count_x;
+
+    // Line 1 at position y
+    m1 = ((int32_t)(table_z[y+x_1] - table_z[y+x]) * 1000L) / (int32_t)(table_x[x_1] - table_x[x]);
+    b1 = table_z[y+x] - (m1 * table_x[x]) / 1000L;
+    z1 = (m1 * val_x) / 1000L + b1;
+
+    // Line 2 at position y+1
+    m2 = ((int32_t)(table_z[y_1+x_1] - table_z[y_1+x]) * 1000L) / (int32_t)(table_x[x_1] - table_x[x]);
+    b2 = table_z[y_1+x] - (m2 * table_x[x]) / 1000L;
+    z2 = (m2 * val_x) / 1000L + b2;
+
+    // Third line orthogonal with 2 new points y1,y2
+    m3 = ((z2-z1) * 1000L) / (table_y[y_raw+1] - table_y[y_raw]);
+    b3 = z1 - (m3 * table_y[y_raw]) / 1000L;
+    z  = (m3 * val_y) / 1000L + b3;
+
+    if( z > NR_MAX_INT16 )
+    {
+        z = NR_MAX_INT16;
+    }
+    else if( z < NR_MIN_INT16 )
+    {
+        z = NR_MIN_INT16;
+    }
+    else
+    {
+        // do nothing
+    }
+
+    return (int16_t)z;
+}
+
 /** \} */
@@ -65,6 +65,18 @@ typedef enum
     LUT_MODE_MAX                    ///< Last element in enum. Do not use.
 }enum_LUT_MODE;
 
+// ---------------------------------------------------------------------------------------------------
+// structs
+// ---------------------------------------------------------------------------------------------------
+/** Prepared 1D lookup table, see os_util_lut1D_prepare(). */
+typedef struct
+{
+    const int16_t *table_x;     ///< x-values, strictly ascending
+    const int16_t *table_y;     ///< y-values
+    int32_t       *slope;       ///< (count - 1) slopes of the segments in 1/65536 y per x
+    uint16_t       count;       ///< number of points
+}struct_lut1D;
+
 // ---------------------------------------------------------------------------------------------------
 // function prototypes
 // ---------------------------------------------------------------------------------------------------
@@ -173,6 +185,99 @@ int16_t os_util_lookup2D   (int16_t *table_x, int16_t *table_y, uint8_t count_x,
 */
 int32_t os_util_lookup2D_32(int32_t *table_x, int32_t *table_y, uint8_t count_x, uint8_t count_y, int32_t *table_z, int32_t val_x, int32_t val_y);
 
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Lookup table (LUT) 1D (16-Bit) with binary search
+* \details  Same parameters and same result as os_util_lookup1D(), but the segment is found with a binary search
+*           instead of a linear scan of table_x. Use it for tables with more than ~8 points.
+*
+* \param    *table_x     [in] int16_t   Pointer to x-values array, ascending order. Minimum is 2 elements.
+* \param    *table_y     [in] int16_t   Pointer to y-values array.
+* \param    count_points [in] uint16_t  Number of elements in the x and y-array
+* \param    val_x        [in] int16_t   The value for that should be converted to y.
+* \param    mode         [in] uint8_t   See #enum_LUT_MODE
+* \return   int16_t                 The calculated y value.
+*/
+int16_t os_util_lookup1D_bsearch(const int16_t *table_x, const int16_t *table_y, uint16_t count_points, int16_t val_x, enum_LUT_MODE mode);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Lookup table (LUT) 1D (32-Bit) with binary search
+* \details  Same parameters and same result as os_util_lookup1D_32() for all valid modes, but the segment is found
+*           with a binary search. Returns 0 for an invalid mode or less than 2 points.
+*
+* \param    *table_x [in] int32_t   Pointer to x-values array, ascending order. Minimum is 2 elements.
+* \param    *table_y [in] int32_t   Pointer to y-values array.
+* \param    count    [in] uint16_t  Number of elements in the x and y-array
+* \param    val      [in] int32_t   The value for that should be converted to y.
+* \param    mode     [in] uint8_t   See #enum_LUT_MODE
+* \return   int32_t                 The calculated y value.
+*/
+int32_t os_util_lookup1D_32_bsearch(const int32_t *table_x, const int32_t *table_y, uint16_t count, int32_t val, enum_LUT_MODE mode);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Lookup table (LUT) 1D (16-Bit) on a uniform grid
+* \details  The x-values are x0 + i * 2^x_shift, so only the y-values are stored. The segment is found with a
+*           shift and the interpolation needs no division. The result is rounded down, so it can differ by 1
+*           from os_util_lookup1D() with the same points.
+*           LUT_MODE_LIMIT limits to the first and the last y-value, LUT_MODE_CALIBRATION keeps the difference
+*           x - y of the second last point above the table (as os_util_lookup1D()) and is limited to >= 0.
+*
+* \param    *table_y  [in] int16_t   Pointer to y-values array.
+* \param    count     [in] uint16_t  Number of elements in the y-array, minimum is 2.
+* \param    x0        [in] int16_t   x-value of table_y[0]
+* \param    x_shift   [in] uint8_t   distance of the x-values is 2^x_shift, 0..14
+* \param    val_x     [in] int16_t   The value for that should be converted to y.
+* \param    mode      [in] uint8_t   See #enum_LUT_MODE
+* \return   int16_t                  The calculated y value, 0 for invalid parameters.
+*/
+int16_t os_util_lookup1D_uniform(const int16_t *table_y, uint16_t count, int16_t x0, uint8_t x_shift, int16_t val_x, enum_LUT_MODE mode);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Prepares a 1D lookup table for os_util_lut1D().
+* \details  The slopes of all segments are calculated once, so os_util_lut1D() needs a binary search and one
+*           multiplication. table_x and table_y are referenced, not copied: call this function again if they change.
+*
+* \param    *lut     [out] struct_lut1D  Prepared table
+* \param    *table_x [in]  int16_t       Pointer to x-values array, strictly ascending.
+* \param    *table_y [in]  int16_t       Pointer to y-values array.
+* \param    count    [in]  uint16_t      Number of elements in the x and y-array, minimum is 2.
+* \param    *slope   [in]  int32_t       Memory for count - 1 slopes.
+* \return   uint8_t                      FALSE if the points aren't ascending or a slope exceeds +-32767 y per x.
+*/
+uint8_t os_util_lut1D_prepare(struct_lut1D *lut, const int16_t *table_x, const int16_t *table_y, uint16_t count, int32_t *slope);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Lookup table (LUT) 1D (16-Bit) with a prepared table
+* \details  Interpolation with the slopes of os_util_lut1D_prepare(). The result is rounded down, so it can differ
+*           by 1 from os_util_lookup1D(). The modes work as for os_util_lookup1D_uniform().
+*
+* \param    *lut   [in] struct_lut1D  Table prepared by os_util_lut1D_prepare()
+* \param    val_x  [in] int16_t       The value for that should be converted to y.
+* \param    mode   [in] uint8_t       See #enum_LUT_MODE
+* \return   int16_t                   The calculated y value, 0 for an invalid table.
+*/
+int16_t os_util_lut1D(const struct_lut1D *lut, int16_t val_x, enum_LUT_MODE mode);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Calculates an output for 2 Parameter inputs (16 Bit) with binary search
+* \details  Same parameters and same result as os_util_lookup2D(), but the segments of both axes are found with
+*           a binary search.
+*
+* \param    *table_x [in] int16_t   Pointer to x-values array (1D)
+* \param    *table_y [in] int16_t   Pointer to y-values array (1D)
+* \param    count_x  [in] uint8_t   Number of elements of x-array
+* \param    count_y  [in] uint8_t   Number of elements of y-array
+* \param    table_z  [in] int16_t   Pointer z-array (1D with (count_y * count_x) elements)
+* \param    val_x    [in] int16_t   x-value input
+* \param    val_y    [in] int16_t   y-value input
+* \return   int16_t                 z-value output
+*/
+int16_t os_util_lookup2D_bsearch(const int16_t *table_x, const int16_t *table_y, uint8_t count_x, uint8_t count_y, const int16_t *table_z, int16_t val_x, int16_t val_y);
 
 /** \}*/
 #endif
@@ -18,9 +18,10 @@
 *               1  | Initial version.
 *               2  | Increase possible count of table.
 *				3  | Fastened lookup1D with better calculation resolution. (Jokis changes)
+*               4  | Binary search, uniform grid and prepared table variants of the lookup functions.
 */
 /*----------------------------------------------------------------------------*/
 
-#define SFL_MATH_VERSION     3       ///< Version Number (integer) of sfl_math.
+#define SFL_MATH_VERSION     4       ///< Version Number (integer) of sfl_math.
 /** \}*/
 #endif
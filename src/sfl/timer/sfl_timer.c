@@ -20,6 +20,13 @@
 // module globals
 // ---------------------------------------------------------------------------------------------------
 static uint8_t mgl_roundtrip_init_flg = FALSE;      ///< Global flag that indicates if initialization for roundtrip already performed.
+static uint8_t mgl_tick_active = FALSE;             ///< Global flag that indicates if sfl_timer_tick_1ms updates the inline time base.
+
+// ---------------------------------------------------------------------------------------------------
+// global variables
+// ---------------------------------------------------------------------------------------------------
+volatile uint32_t ext_sfl_timer_now_ms = 0u;
+uint32_t ext_sfl_timer_epoch_ms = 0u;
 
 /*----------------------------------------------------------------------------*/
 /**
@@ -46,16 +53,39 @@ void sfl_timer_deinit(void)
 /*----------------------------------------------------------------------------*/
 /**
 * \internal
+* Takes the timestamp of the HAL once per tick, instead of every reader calling it.
+* \endinternal
+*
+*/
+void sfl_timer_tick_1ms(void)
+{
+	uint32_t now = 0u;
+
+	if (hal_get_timestamp(&now, HAL_PRECISION_1MS) == HAL_TICK_OK)
+	{
+		ext_sfl_timer_now_ms = now;
+		mgl_tick_active = TRUE;
+	}
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* ms from the inline time base once it runs.
 * \endinternal
 *
 */
 enum_SFL_TIMER_ERR sfl_timer_set_timestamp(uint32_t* timestamp, enum_HAL_PRECISION precision)
 {
 	//local variables
-	volatile enum_SFL_TIMER_ERR ret_val = SFL_TIMER_ERR_OK;
+	enum_SFL_TIMER_ERR ret_val = SFL_TIMER_ERR_OK;
 
 	//get timestamp
-	if (hal_get_timestamp(timestamp, precision) != HAL_TICK_OK)
+	if ( (precision == HAL_PRECISION_1MS) && (mgl_tick_active == TRUE) )
+	{
+		*timestamp = ext_sfl_timer_now_ms;
+	}
+	else if (hal_get_timestamp(timestamp, precision) != HAL_TICK_OK)
 	{
 		ret_val = SFL_TIMER_ERR_PRECISION_INVALID;
 	}
@@ -79,11 +109,11 @@ enum_SFL_TIMER_ERR sfl_timer_set_timestamp(uint32_t* timestamp, enum_HAL_PRECISI
 enum_SFL_TIMER_ERR sfl_timer_get_time_elapsed(uint32_t* time_elapsed, uint32_t timestamp_t0, enum_HAL_PRECISION precision)
 {
 	//local variables
-	volatile enum_SFL_TIMER_ERR ret_val = SFL_TIMER_ERR_GENERAL;
+	enum_SFL_TIMER_ERR ret_val = SFL_TIMER_ERR_GENERAL;
 	uint32_t timestamp_now = 0;
 
 	//get timestamp
-	if (hal_get_timestamp(&timestamp_now, precision) != HAL_TICK_OK)
+	if (sfl_timer_set_timestamp(&timestamp_now, precision) != SFL_TIMER_ERR_OK)
 	{
 		ret_val = SFL_TIMER_ERR_PRECISION_INVALID;
 	}
@@ -116,7 +146,7 @@ enum_SFL_TIMER_ERR sfl_timer_get_time_elapsed(uint32_t* time_elapsed, uint32_t t
 enum_SFL_TIMER_ERR sfl_timer_time_elapsed(uint8_t* elapsed, uint32_t timestamp_t0, uint32_t span, enum_HAL_PRECISION precision)
 {
 	//local variables
-	volatile enum_SFL_TIMER_ERR ret_val = SFL_TIMER_ERR_GENERAL;
+	enum_SFL_TIMER_ERR ret_val = SFL_TIMER_ERR_GENERAL;
 	uint32_t time_elapsed = 0;
 
 	//get time elapsed
@@ -207,17 +237,8 @@ enum_SFL_TIMER_ERR sfl_timer_get_roundtrip_time(uint32_t* roundtrip_time, enum_H
 
         else
         {
-            //over flow ?
-            if (timestamp_t0 < timestamp_t1)
-            {
-                //calculate roundtrip time
-                *roundtrip_time = timestamp_t1 - timestamp_t0;
-            }
-
-            else
-            {
-                *roundtrip_time = timestamp_t0 - timestamp_t1;
-            }
+            //calculate roundtrip time, modulo 2^32 also right after an overflow
+            *roundtrip_time = timestamp_t1 - timestamp_t0;
 
             //take over
             timestamp_t0 = timestamp_t1;
@@ -41,6 +41,21 @@
 *        }
 *    }
 * \endcode
+*
+*   Inline time base:
+*   -----------------
+*   sfl_timer_tick_1ms, called by the 1 ms timer interrupt, copies the ms timestamp of the HAL into a
+*   variable. sfl_timer_now_ms reads it with one load, without the error checked HAL call. The main loop
+*   takes it once per pass with sfl_timer_epoch_update, so everything done in one pass compares against
+*   the same time (sfl_timer_epoch_ms). The helpers compare modulo 2^32, they stay right across the
+*   wrap of the counter after 49.7 days, no special case for SFL_TIMER_ERR_OVERFLOW is needed.
+* \code{.c}
+*    if (sfl_timer_is_elapsed(timestamp, 1000u, sfl_timer_epoch_ms()) == TRUE)
+*    {
+*        timestamp = sfl_timer_epoch_ms();
+*        ...
+*    }
+* \endcode
 *   For version information see file sfl_timer_version.h    
 */
 /*----------------------------------------------------------------------------*/
@@ -65,10 +80,76 @@ typedef enum
     SFL_TIMER_ERR_GENERAL
 } enum_SFL_TIMER_ERR;
 
+// ---------------------------------------------------------------------------------------------------
+// global variables
+// ---------------------------------------------------------------------------------------------------
+extern volatile uint32_t ext_sfl_timer_now_ms;      ///< ms timestamp of the last tick, read by sfl_timer_now_ms
+extern uint32_t ext_sfl_timer_epoch_ms;             ///< ms timestamp of the current main loop pass
+
+// ---------------------------------------------------------------------------------------------------
+// inline functions
+// ---------------------------------------------------------------------------------------------------
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Current time in ms, same value as hal_get_timestamp with HAL_PRECISION_1MS.
+* \details  Needs sfl_timer_tick_1ms in the 1 ms timer interrupt. Callable from interrupts.
+*
+* \return   uint32_t
+*/
+static inline uint32_t sfl_timer_now_ms(void)
+{
+    return ext_sfl_timer_now_ms;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Time in ms taken at the start of the current main loop pass.
+*
+* \return   uint32_t
+*/
+static inline uint32_t sfl_timer_epoch_ms(void)
+{
+    return ext_sfl_timer_epoch_ms;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Takes the time of the main loop pass, called once at the start of each pass.
+*
+* \return   void
+*/
+static inline void sfl_timer_epoch_update(void)
+{
+    ext_sfl_timer_epoch_ms = ext_sfl_timer_now_ms;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Checks if span has elapsed since timestamp_t0.
+*
+* \param    timestamp_t0    [in] uint32_t
+* \param    span            [in] uint32_t   same unit as the timestamps, < 2^32
+* \param    now             [in] uint32_t   e.g. sfl_timer_epoch_ms()
+* \return   uint8_t                         TRUE if elapsed
+*/
+static inline uint8_t sfl_timer_is_elapsed(uint32_t timestamp_t0, uint32_t span, uint32_t now)
+{
+    return ((now - timestamp_t0) >= span) ? TRUE : FALSE;
+}
+
 // ---------------------------------------------------------------------------------------------------
 // function prototypes
 // ---------------------------------------------------------------------------------------------------
 
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Updates the inline time base, called by the 1 ms timer interrupt.
+*
+* \return   void
+*/
+void sfl_timer_tick_1ms(void);
+
 /*----------------------------------------------------------------------------*/
 /**
 * \brief    Initializes the timer module
@@ -20,10 +20,13 @@
 *   Version Number |  Description
 *   ---------------|--------------------------------------------------------------------
 *               1  | Initial version.     
+*               2  | - added inline time base sfl_timer_now_ms / sfl_timer_epoch_ms, updated by sfl_timer_tick_1ms
+*                  | - added sfl_timer_is_elapsed, compares modulo 2^32
+*                  | - sfl_timer_get_roundtrip_time returns t1 - t0 also after an overflow
 */
 /*----------------------------------------------------------------------------*/
 
-#define SFL_TIMER_VERSION     1 ///< Version Number (integer) of sfl_timer.
+#define SFL_TIMER_VERSION     2 ///< Version Number (integer) of sfl_timer.
 
 /** \} */
 #endif // SFL_TIMER_VERSION_H
@@ -0,0 +1,599 @@
+/*----------------------------------------------------------------------------*/
+/**
+ * \file         hal_sim.c
+ * \brief        Host simulation of the HAL tick, sys and CAN interfaces.
+ * \details      Replaces the prebuilt S32K HAL library in the host build, see
+ *               hal_sim.h for the model. Everything runs in one thread: the rx
+ *               hook is called from #hal_sim_time_advance_us just like the
+ *               FlexCAN ISR interrupts the super-loop on the target.
+ * \date         20261019
+ *
+ */
+/*----------------------------------------------------------------------------*/
+
+// ---------------------------------------------------------------------------------------------------
+// includes
+// ---------------------------------------------------------------------------------------------------
+#include <string.h>
+#include "hal_sim.h"
+#include "hal_tick.h"
+#include "hal_sys.h"
+
+// ---------------------------------------------------------------------------------------------------
+// defines
+// ---------------------------------------------------------------------------------------------------
+#define HAL_SIM_FOREIGN_LOAD_MAX    95u
+#define HAL_SIM_NO_EVENT            UINT64_MAX
+
+// ---------------------------------------------------------------------------------------------------
+// typedefs
+// ---------------------------------------------------------------------------------------------------
+typedef struct
+{
+    struct_hal_can_frame    header;
+    uint8_t                 data[HAL_SIM_CAN_PAYLOAD_MAX];
+    uint64_t                start_us;
+} struct_hal_sim_can_pending;
+
+typedef struct
+{
+    struct_hal_sim_can_bus_cfg  cfg;
+    struct_hal_sim_can_stats    stats;
+    uint64_t                    wire_free_us;                       ///< end of the last frame on the wire
+    uint64_t                    mb_busy_us[HAL_SIM_CAN_TX_MB_MAX];  ///< end of transmission of each TX message box
+    struct_hal_sim_can_pending  pending[HAL_SIM_CAN_PENDING_MAX];
+    uint32_t                    pending_read;
+    uint32_t                    pending_count;
+} struct_hal_sim_can_bus;
+
+// ---------------------------------------------------------------------------------------------------
+// module globals
+// ---------------------------------------------------------------------------------------------------
+static uint64_t mgl_sim_time_us = 0u;
+static uint32_t mgl_sim_critical_cnt = 0u;
+static callback_timer_1ms_t mgl_sim_cb_1ms = NULL_PTR;
+static callback_timer_1ms_t mgl_sim_cb_lin_1ms = NULL_PTR;
+static hal_sim_can_rx_hook_t mgl_sim_rx_hook = NULL_PTR;
+static hal_sim_can_tx_hook_t mgl_sim_tx_hook = NULL_PTR;
+static struct_hal_sim_can_bus mgl_sim_bus[HAL_SIM_CAN_BUS_MAX];
+
+static const uint8_t mgl_sim_dlc_len[HAL_CAN_DLC_MAX] = {0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 12u, 16u, 20u, 24u, 32u, 48u, 64u};
+
+// ---------------------------------------------------------------------------------------------------
+// local functions
+// ---------------------------------------------------------------------------------------------------
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Wire time of a frame stretched by the foreign bus load.
+* \endinternal
+*/
+static uint64_t hal_sim_can_wire_time_us(const struct_hal_sim_can_bus* ptr_bus, const struct_hal_can_frame* ptr_can_msg)
+{
+    uint64_t duration = hal_sim_can_frame_time_us(ptr_bus->cfg.bitrate, ptr_can_msg);
+
+    return (duration * 100u) / (100u - ptr_bus->cfg.foreign_load_pct);
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Time at which the oldest pending frame of a bus reaches the rx hook.
+* \endinternal
+*/
+static uint64_t hal_sim_can_next_delivery_us(const struct_hal_sim_can_bus* ptr_bus, uint64_t* ptr_end_us)
+{
+    uint64_t ret_val = HAL_SIM_NO_EVENT;
+
+    if (ptr_bus->pending_count > 0u)
+    {
+        const struct_hal_sim_can_pending* ptr_pending = &ptr_bus->pending[ptr_bus->pending_read];
+        uint64_t start = (ptr_pending->start_us > ptr_bus->wire_free_us) ? ptr_pending->start_us : ptr_bus->wire_free_us;
+
+        *ptr_end_us = start + hal_sim_can_wire_time_us(ptr_bus, &ptr_pending->header);
+        ret_val = *ptr_end_us + ptr_bus->cfg.rx_latency_us;
+    }
+
+    return ret_val;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Delivers all frames due until the given time in time order over all buses.
+* \endinternal
+*/
+static void hal_sim_can_process(const uint64_t until_us)
+{
+    uint8_t bus_id;
+    uint8_t next_bus;
+    uint64_t next_us, next_end_us, end_us;
+
+    do
+    {
+        next_bus = HAL_SIM_CAN_BUS_MAX;
+        next_us = HAL_SIM_NO_EVENT;
+        next_end_us = 0u;
+
+        for (bus_id = 0u; bus_id < HAL_SIM_CAN_BUS_MAX; bus_id++)
+        {
+            uint64_t delivery_us = hal_sim_can_next_delivery_us(&mgl_sim_bus[bus_id], &end_us);
+            if ( (delivery_us <= until_us) && (delivery_us < next_us) )
+            {
+                next_bus = bus_id;
+                next_us = delivery_us;
+                next_end_us = end_us;
+            }
+        }
+
+        if (next_bus < HAL_SIM_CAN_BUS_MAX)
+        {
+            struct_hal_sim_can_bus* ptr_bus = &mgl_sim_bus[next_bus];
+            struct_hal_sim_can_pending* ptr_pending = &ptr_bus->pending[ptr_bus->pending_read];
+
+            ptr_bus->stats.wire_busy_us += hal_sim_can_frame_time_us(ptr_bus->cfg.bitrate, &ptr_pending->header);
+            ptr_bus->wire_free_us = next_end_us;
+            ptr_bus->pending_read = (ptr_bus->pending_read + 1u) % HAL_SIM_CAN_PENDING_MAX;
+            ptr_bus->pending_count--;
+
+            if (next_us > mgl_sim_time_us)
+            {
+                mgl_sim_time_us = next_us;
+            }
+
+            ptr_bus->stats.rx_delivered++;
+            if (mgl_sim_rx_hook != NULL_PTR)
+            {
+                ptr_pending->header.ptr_data = ptr_pending->data;
+                mgl_sim_rx_hook(next_bus, &ptr_pending->header);
+            }
+        }
+    } while (next_bus < HAL_SIM_CAN_BUS_MAX);
+}
+
+// ---------------------------------------------------------------------------------------------------
+// simulation control
+// ---------------------------------------------------------------------------------------------------
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+*
+* \test STATUS: *** UNTESTED ***
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void hal_sim_reset(void)
+{
+    mgl_sim_time_us = 0u;
+    mgl_sim_critical_cnt = 0u;
+    memset(mgl_sim_bus, 0, sizeof(mgl_sim_bus));
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+*
+* \test STATUS: *** UNTESTED ***
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint64_t hal_sim_time_get_us(void)
+{
+    return mgl_sim_time_us;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Millisecond boundaries are handled one by one so that the 1ms callback sees
+* the CAN frames in the same order as on the target.
+* \endinternal
+*
+*
+* \test STATUS: *** UNTESTED ***
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void hal_sim_time_advance_us(uint32_t delta_us)
+{
+    const uint64_t target_us = mgl_sim_time_us + delta_us;
+    uint64_t next_ms_us = ((mgl_sim_time_us / 1000u) + 1u) * 1000u;
+
+    while (next_ms_us <= target_us)
+    {
+        hal_sim_can_process(next_ms_us);
+        mgl_sim_time_us = next_ms_us;
+
+        if (mgl_sim_cb_1ms != NULL_PTR)
+        {
+            mgl_sim_cb_1ms();
+        }
+        if (mgl_sim_cb_lin_1ms != NULL_PTR)
+        {
+            mgl_sim_cb_lin_1ms();
+        }
+        next_ms_us += 1000u;
+    }
+
+    hal_sim_can_process(target_us);
+    mgl_sim_time_us = target_us;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+*
+* \test STATUS: *** UNTESTED ***
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+enum_HAL_CAN_RETURN_VALUE hal_sim_can_configure(uint8_t bus_id, const struct_hal_sim_can_bus_cfg* ptr_cfg)
+{
+    enum_HAL_CAN_RETURN_VALUE ret_val = HAL_CAN_ERROR_CHANNEL_INVALID;
+
+    if ( (bus_id < HAL_SIM_CAN_BUS_MAX) && (ptr_cfg != NULL_PTR) )
+    {
+        mgl_sim_bus[bus_id].cfg = *ptr_cfg;
+        if (mgl_sim_bus[bus_id].cfg.foreign_load_pct > HAL_SIM_FOREIGN_LOAD_MAX)
+        {
+            mgl_sim_bus[bus_id].cfg.foreign_load_pct = HAL_SIM_FOREIGN_LOAD_MAX;
+        }
+        ret_val = HAL_CAN_OK;
+    }
+
+    return ret_val;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+*
+* \test STATUS: *** UNTESTED ***
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void hal_sim_can_set_hooks(hal_sim_can_rx_hook_t rx_hook, hal_sim_can_tx_hook_t tx_hook)
+{
+    mgl_sim_rx_hook = rx_hook;
+    mgl_sim_tx_hook = tx_hook;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+*
+* \test STATUS: *** UNTESTED ***
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+enum_HAL_CAN_RETURN_VALUE hal_sim_can_inject(uint8_t bus_id, const struct_hal_can_frame* ptr_can_msg, uint64_t start_us)
+{
+    enum_HAL_CAN_RETURN_VALUE ret_val = HAL_CAN_ERROR_CHANNEL_INVALID;
+
+    if ( (bus_id < HAL_SIM_CAN_BUS_MAX) && (ptr_can_msg != NULL_PTR) )
+    {
+        struct_hal_sim_can_bus* ptr_bus = &mgl_sim_bus[bus_id];
+
+        if (ptr_bus->pending_count >= HAL_SIM_CAN_PENDING_MAX)
+        {
+            ptr_bus->stats.rx_lost++;
+            ret_val = HAL_CAN_ERROR_BUSY;
+        }
+        else
+        {
+            uint32_t idx = (ptr_bus->pending_read + ptr_bus->pending_count) % HAL_SIM_CAN_PENDING_MAX;
+            struct_hal_sim_can_pending* ptr_pending = &ptr_bus->pending[idx];
+            uint8_t len = hal_can_dlc_to_len(ptr_can_msg->can_dlc);
+
+            ptr_pending->header = *ptr_can_msg;
+            ptr_pending->header.ptr_data = ptr_pending->data;
+            memset(ptr_pending->data, 0, sizeof(ptr_pending->data));
+            if (ptr_can_msg->ptr_data != NULL_PTR)
+            {
+                memcpy(ptr_pending->data, ptr_can_msg->ptr_data, len);
+            }
+            ptr_pending->start_us = start_us;
+            ptr_bus->pending_count++;
+            ret_val = HAL_CAN_OK;
+        }
+    }
+
+    return ret_val;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+*
+* \test STATUS: *** UNTESTED ***
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint32_t hal_sim_can_get_pending(uint8_t bus_id)
+{
+    return (bus_id < HAL_SIM_CAN_BUS_MAX) ? mgl_sim_bus[bus_id].pending_count : 0u;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+*
+* \test STATUS: *** UNTESTED ***
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+void hal_sim_can_get_stats(uint8_t bus_id, struct_hal_sim_can_stats* ptr_stats)
+{
+    if ( (bus_id < HAL_SIM_CAN_BUS_MAX) && (ptr_stats != NULL_PTR) )
+    {
+        *ptr_stats = mgl_sim_bus[bus_id].stats;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Bit count of a classic frame: SOF, arbitration, control, data, CRC, ACK, EOF
+* and intermission = 47 + 8n bits (standard id) resp. 67 + 8n bits (extended
+* id), plus one stuff bit for every 4 bits of the stuffed part in the worst case.
+* CAN FD frames are timed with the arbitration bitrate.
+* \endinternal
+*
+*
+* \test STATUS: *** UNTESTED ***
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint32_t hal_sim_can_frame_time_us(uint32_t bitrate, const struct_hal_can_frame* ptr_can_msg)
+{
+    uint32_t ret_val = 0u;
+
+    if (bitrate > 0u)
+    {
+        uint32_t data_bits = 8u * hal_can_dlc_to_len(ptr_can_msg->can_dlc);
+        uint32_t bits;
+
+        if ( (ptr_can_msg->can_id >> 31) != 0u )
+        {
+            bits = 67u + data_bits + ((54u + data_bits - 1u) / 4u);
+        }
+        else
+        {
+            bits = 47u + data_bits + ((34u + data_bits - 1u) / 4u);
+        }
+
+        ret_val = (uint32_t)(((uint64_t)bits * 1000000u + bitrate - 1u) / bitrate);
+    }
+
+    return ret_val;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* \endinternal
+*
+*
+* \test STATUS: *** UNTESTED ***
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+uint32_t hal_sim_get_critical_section_count(void)
+{
+    return mgl_sim_critical_cnt;
+}
+
+// ---------------------------------------------------------------------------------------------------
+// hal_tick
+// ---------------------------------------------------------------------------------------------------
+
+enum_HAL_TICK_RETURN_VALUE hal_tick_init(void)
+{
+    return HAL_TICK_OK;
+}
+
+enum_HAL_TICK_RETURN_VALUE hal_tick_deinit(void)
+{
+    return HAL_TICK_OK;
+}
+
+enum_HAL_TICK_RETURN_VALUE hal_get_timestamp(uint32_t* timestamp, enum_HAL_PRECISION precision)
+{
+    static const uint32_t divider[] = {1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u};
+    enum_HAL_TICK_RETURN_VALUE ret_val = HAL_TICK_ERROR_PRECISION_INVALID;
+
+    if ( (timestamp != NULL_PTR) && ((uint32_t)precision <= (uint32_t)HAL_PRECISION_1S) )
+    {
+        *timestamp = (uint32_t)(mgl_sim_time_us / divider[precision]);
+        ret_val = HAL_TICK_OK;
+    }
+
+    return ret_val;
+}
+
+void hal_tick_set_tick(enum_HAL_PRECISION precision)
+{
+    (void)precision;
+}
+
+void set_callback_timer_1ms(callback_timer_1ms_t callback)
+{
+    mgl_sim_cb_1ms = callback;
+}
+
+void set_callback_timer_lin_1ms(callback_timer_1ms_t callback)
+{
+    mgl_sim_cb_lin_1ms = callback;
+}
+
+// ---------------------------------------------------------------------------------------------------
+// hal_sys
+// ---------------------------------------------------------------------------------------------------
+
+void hal_sys_disable_all_interrupts(void)
+{
+    mgl_sim_critical_cnt++;
+}
+
+void hal_sys_enable_all_interrupts(void)
+{
+    // the rx hook is only called from hal_sim_time_advance_us, nothing to unlock
+}
+
+// ---------------------------------------------------------------------------------------------------
+// hal_can
+// ---------------------------------------------------------------------------------------------------
+
+enum_HAL_CAN_RETURN_VALUE hal_can_init(struct_hal_can_handle* ptr_can_handle, uint8_t bus_id, _Bool block_mode)
+{
+    enum_HAL_CAN_RETURN_VALUE ret_val = HAL_CAN_ERROR_INIT_FAILED;
+    (void)block_mode;
+
+    if ( (ptr_can_handle != NULL_PTR) && (bus_id < HAL_SIM_CAN_BUS_MAX) )
+    {
+        ptr_can_handle->can_handle_number = bus_id;
+        ret_val = HAL_CAN_OK;
+    }
+
+    return ret_val;
+}
+
+enum_HAL_CAN_RETURN_VALUE hal_can_deinit(struct_hal_can_handle* ptr_can_handle)
+{
+    (void)ptr_can_handle;
+    return HAL_CAN_OK;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* A message box is busy until its frame has left the wire. The frame is queued
+* behind the frames already on the wire, there is no arbitration against
+* injected frames.
+* \endinternal
+*
+*
+* \test STATUS: *** UNTESTED ***
+* Date       | Type    | Person
+* -----------|---------|-----------
+* 20261019   | Author  | agent
+*/
+enum_HAL_CAN_RETURN_VALUE hal_can_send(const struct_hal_can_handle* ptr_can_handle, const struct_hal_can_frame* ptr_can_msg)
+{
+    enum_HAL_CAN_RETURN_VALUE ret_val = HAL_CAN_ERROR_CHANNEL_INVALID;
+
+    if ( (ptr_can_handle != NULL_PTR) && (ptr_can_msg != NULL_PTR)
+      && (ptr_can_handle->can_handle_number >= 0) && (ptr_can_handle->can_handle_number < (int32_t)HAL_SIM_CAN_BUS_MAX) )
+    {
+        uint8_t bus_id = (uint8_t)ptr_can_handle->can_handle_number;
+        struct_hal_sim_can_bus* ptr_bus = &mgl_sim_bus[bus_id];
+        uint8_t mb;
+
+        ret_val = HAL_CAN_ERROR_BUSY;
+        for (mb = 0u; mb < HAL_SIM_CAN_TX_MB_MAX; mb++)
+        {
+            if (ptr_bus->mb_busy_us[mb] <= mgl_sim_time_us)
+            {
+                uint64_t start = (mgl_sim_time_us > ptr_bus->wire_free_us) ? mgl_sim_time_us : ptr_bus->wire_free_us;
+
+                ptr_bus->wire_free_us = start + hal_sim_can_wire_time_us(ptr_bus, ptr_can_msg);
+                ptr_bus->mb_busy_us[mb] = ptr_bus->wire_free_us;
+                ptr_bus->stats.wire_busy_us += hal_sim_can_frame_time_us(ptr_bus->cfg.bitrate, ptr_can_msg);
+                ptr_bus->stats.tx_sent++;
+
+                if (mgl_sim_tx_hook != NULL_PTR)
+                {
+                    mgl_sim_tx_hook(bus_id, ptr_can_msg);
+                }
+                ret_val = HAL_CAN_OK;
+                break;
+            }
+        }
+
+        if (ret_val == HAL_CAN_ERROR_BUSY)
+        {
+            ptr_bus->stats.tx_busy++;
+        }
+    }
+
+    return ret_val;
+}
+
+enum_HAL_CAN_RETURN_VALUE hal_can_receive(const struct_hal_can_handle* ptr_can_handle, struct_hal_can_frame* ptr_can_msg)
+{
+    // frames are pushed through the rx hook, there is no message box to poll
+    (void)ptr_can_handle;
+    (void)ptr_can_msg;
+    return HAL_CAN_ERROR_NO_MESSAGE;
+}
+
+enum_HAL_CAN_RETURN_VALUE hal_can_set_filter(const struct_hal_can_handle* ptr_can_handle, const struct_hal_can_filter* ptr_can_filter)
+{
+    (void)ptr_can_handle;
+    (void)ptr_can_filter;
+    return HAL_CAN_OK;
+}
+
+enum_HAL_CAN_RETURN_VALUE hal_can_set_receive_callback(struct_hal_can_handle* ptr_can_handle, hal_can_rx_callback_function_type ptr_cb_function)
+{
+    (void)ptr_can_handle;
+    (void)ptr_cb_function;
+    return HAL_CAN_OK;
+}
+
+enum_HAL_CAN_RETURN_VALUE hal_can_set_baudrate(struct_hal_can_handle* ptr_can_handle, enum_HAL_CAN_BAUDRATE baudrate)
+{
+    (void)ptr_can_handle;
+    (void)baudrate;
+    return HAL_CAN_OK;
+}
+
+enum_HAL_CAN_RETURN_VALUE hal_can_set_fd_data_baudrate(struct_hal_can_handle* ptr_can_handle, enum_HAL_CAN_BAUDRATE baudrate)
+{
+    (void)ptr_can_handle;
+    (void)baudrate;
+    return HAL_CAN_OK;
+}
+
+uint8_t hal_can_len_to_dlc(uint8_t len)
+{
+    uint8_t dlc = 0u;
+
+    while ( (dlc < (HAL_CAN_DLC_MAX - 1u)) && (mgl_sim_dlc_len[dlc] < len) )
+    {
+        dlc++;
+    }
+
+    return dlc;
+}
+
+uint8_t hal_can_dlc_to_len(uint8_t dlc)
+{
+    return (dlc < HAL_CAN_DLC_MAX) ? mgl_sim_dlc_len[dlc] : mgl_sim_dlc_len[HAL_CAN_DLC_MAX - 1u];
+}
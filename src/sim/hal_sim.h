@@ -0,0 +1,169 @@
+#ifndef HAL_SIM_H
+#define HAL_SIM_H
+/*----------------------------------------------------------------------------*/
+/**
+* \file         hal_sim.h
+* \brief        Control interface of the host simulation HAL.
+* \details      The host simulation replaces the prebuilt S32K HAL by an
+*               in-process implementation so that the sfl CAN stack
+*               (sfl_can_db, sfl_fifo, sfl_db, sfl_timer) can be built and
+*               measured on a Linux PC.
+*
+*               - virtual time: #hal_get_timestamp returns the simulated time,
+*                 which is only moved by #hal_sim_time_advance_us.
+*               - virtual CAN bus: every bus has a wire model with a bitrate and
+*                 an optional foreign bus load. Frames injected with
+*                 #hal_sim_can_inject are delivered through the rx callback
+*                 once the wire is free, frames sent with #hal_can_send occupy
+*                 the wire and one of the TX message boxes.
+* \date         20261019
+*
+*/
+/*----------------------------------------------------------------------------*/
+
+// ---------------------------------------------------------------------------------------------------
+// includes
+// ---------------------------------------------------------------------------------------------------
+#include "hal_data_types.h"
+#include "hal_can.h"
+
+// ---------------------------------------------------------------------------------------------------
+// defines
+// ---------------------------------------------------------------------------------------------------
+#define HAL_SIM_CAN_BUS_MAX         3u      ///< same as CAN_HANDLE_MAX_NR
+#define HAL_SIM_CAN_TX_MB_MAX       2u      ///< TX message boxes per bus used by the CAN DB (MB 4-5)
+#define HAL_SIM_CAN_PENDING_MAX     4096u   ///< injected frames waiting for the wire per bus
+#define HAL_SIM_CAN_PAYLOAD_MAX     64u     ///< CAN FD payload
+
+// ---------------------------------------------------------------------------------------------------
+// typedefs
+// ---------------------------------------------------------------------------------------------------
+
+/** Wire model of one virtual CAN bus. */
+typedef struct
+{
+    uint32_t bitrate;           ///< bit/s, 0 disables the wire timing (frames are delivered immediately)
+    uint8_t  foreign_load_pct;  ///< percentage of the wire occupied by nodes which are not simulated (0..95)
+    uint32_t rx_latency_us;     ///< delay between end of frame and rx callback (ISR entry)
+} struct_hal_sim_can_bus_cfg;
+
+/** Counters of one virtual CAN bus. */
+typedef struct
+{
+    uint32_t rx_delivered;      ///< frames passed to the rx callback
+    uint32_t rx_lost;           ///< injected frames dropped because the pending queue was full
+    uint32_t tx_sent;           ///< frames accepted by #hal_can_send
+    uint32_t tx_busy;           ///< #hal_can_send calls rejected because all TX message boxes were busy
+    uint64_t wire_busy_us;      ///< time the wire was occupied by simulated frames
+} struct_hal_sim_can_stats;
+
+/** Function called for every frame accepted by #hal_can_send, e.g. to loop frames into another bus. */
+typedef void (*hal_sim_can_tx_hook_t)(uint8_t bus_id, const struct_hal_can_frame* ptr_can_msg);
+
+/** Function called for every frame delivered on a bus (the CAN ISR of the application). */
+typedef void (*hal_sim_can_rx_hook_t)(uint8_t bus_id, const struct_hal_can_frame* ptr_can_msg);
+
+// ---------------------------------------------------------------------------------------------------
+// function prototypes
+// ---------------------------------------------------------------------------------------------------
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Resets the virtual time to 0 and clears all bus queues and statistics.
+*
+* \return   void
+*/
+void hal_sim_reset(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Returns the virtual time in microseconds.
+*
+* \return   uint64_t    simulated time since #hal_sim_reset
+*/
+uint64_t hal_sim_time_get_us(void);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Moves the virtual time forward.
+* \details  Frames which finish on the wire within the step are delivered to the rx hook in
+*           time order, the 1ms callback (see #set_callback_timer_1ms) is called for every
+*           millisecond boundary which is crossed.
+*
+* \param    delta_us [in] uint32_t  time step in microseconds
+* \return   void
+*/
+void hal_sim_time_advance_us(uint32_t delta_us);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Configures the wire model of a virtual bus.
+*
+* \param    bus_id  [in] uint8_t                                bus index
+* \param    ptr_cfg [in] const struct_hal_sim_can_bus_cfg*     wire model
+* \return   enum_HAL_CAN_RETURN_VALUE                           HAL_CAN_ERROR_CHANNEL_INVALID for an invalid bus
+*/
+enum_HAL_CAN_RETURN_VALUE hal_sim_can_configure(uint8_t bus_id, const struct_hal_sim_can_bus_cfg* ptr_cfg);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Installs the rx hook (CAN ISR) and the optional tx hook of all buses.
+*
+* \param    rx_hook [in] hal_sim_can_rx_hook_t  called for every delivered frame
+* \param    tx_hook [in] hal_sim_can_tx_hook_t  called for every sent frame, may be NULL
+* \return   void
+*/
+void hal_sim_can_set_hooks(hal_sim_can_rx_hook_t rx_hook, hal_sim_can_tx_hook_t tx_hook);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Puts a frame on the virtual bus as if another node had sent it.
+* \details  The frame starts at \p start_us or as soon as the wire is free afterwards and is
+*           delivered to the rx hook at the end of frame plus rx_latency_us.
+*           Frames have to be injected in ascending start time per bus.
+*
+* \param    bus_id      [in] uint8_t                        bus index
+* \param    ptr_can_msg [in] const struct_hal_can_frame*    frame, the payload is copied
+* \param    start_us    [in] uint64_t                       earliest start of the frame on the wire
+* \return   enum_HAL_CAN_RETURN_VALUE                       HAL_CAN_ERROR_BUSY if the pending queue is full
+*/
+enum_HAL_CAN_RETURN_VALUE hal_sim_can_inject(uint8_t bus_id, const struct_hal_can_frame* ptr_can_msg, uint64_t start_us);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Returns the number of injected frames which are not yet delivered.
+*
+* \param    bus_id [in] uint8_t     bus index
+* \return   uint32_t                pending frames
+*/
+uint32_t hal_sim_can_get_pending(uint8_t bus_id);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Returns a copy of the counters of a bus.
+*
+* \param    bus_id    [in]  uint8_t                     bus index
+* \param    ptr_stats [out] struct_hal_sim_can_stats*   counters
+* \return   void
+*/
+void hal_sim_can_get_stats(uint8_t bus_id, struct_hal_sim_can_stats* ptr_stats);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Returns the wire time of a frame in microseconds including worst case bit stuffing.
+*
+* \param    bitrate     [in] uint32_t                       bit/s
+* \param    ptr_can_msg [in] const struct_hal_can_frame*    frame
+* \return   uint32_t                                        duration on the wire, 0 if bitrate is 0
+*/
+uint32_t hal_sim_can_frame_time_us(uint32_t bitrate, const struct_hal_can_frame* ptr_can_msg);
+
+/*----------------------------------------------------------------------------*/
+/**
+* \brief    Returns the number of calls to #hal_sys_disable_all_interrupts.
+*
+* \return   uint32_t    number of critical sections entered
+*/
+uint32_t hal_sim_get_critical_section_count(void);
+
+#endif // HAL_SIM_H
@@ -0,0 +1,14 @@
+#ifndef CAN_APP_H
+#define CAN_APP_H
+/*----------------------------------------------------------------------------*/
+/**
+* \file         can_app.h
+* \brief        Host replacement for the application header of the same name.
+* \details      sfl_can_db_tables_data.c includes it but only needs the
+*               declarations which are already provided by the sfl headers.
+* \date         20261019
+*
+*/
+/*----------------------------------------------------------------------------*/
+
+#endif // CAN_APP_H
@@ -0,0 +1,29 @@
+#ifndef FLEXCAN_DRIVER_H
+#define FLEXCAN_DRIVER_H
+/*----------------------------------------------------------------------------*/
+/**
+* \file         flexcan_driver.h
+* \brief        Host replacement for the S32K SDK flexcan driver header.
+* \details      Only the types referenced by sfl headers are declared, the host
+*               simulation never touches the FlexCAN peripheral.
+* \date         20261019
+*
+*/
+/*----------------------------------------------------------------------------*/
+#include <stdint.h>
+
+typedef struct
+{
+    uint32_t dummy;
+} flexcan_state_t;
+
+typedef struct
+{
+    uint32_t propSeg;
+    uint32_t phaseSeg1;
+    uint32_t phaseSeg2;
+    uint32_t preDivider;
+    uint32_t rJumpwidth;
+} flexcan_time_segment_t;
+
+#endif // FLEXCAN_DRIVER_H
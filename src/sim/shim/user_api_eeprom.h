@@ -0,0 +1,14 @@
+#ifndef USER_API_EEPROM_H
+#define USER_API_EEPROM_H
+/*----------------------------------------------------------------------------*/
+/**
+* \file         user_api_eeprom.h
+* \brief        Host replacement for the application header of the same name.
+* \details      sfl_can_db_tables_data.c includes it but only needs the
+*               declarations which are already provided by the sfl headers.
+* \date         20261019
+*
+*/
+/*----------------------------------------------------------------------------*/
+
+#endif // USER_API_EEPROM_H
@@ -0,0 +1,18 @@
+#ifndef USER_CODE_H
+#define USER_CODE_H
+/*----------------------------------------------------------------------------*/
+/**
+* \file         user_code.h
+* \brief        Host replacement for the application header of the same name.
+* \details      sfl_can_db_tables_data.c includes it but only needs the
+*               declarations which are already provided by the sfl headers.
+* \date         20261019
+*
+*/
+/*----------------------------------------------------------------------------*/
+
+// use the baud rate from can_db_tables.c, there is no EEPROM in the host simulation
+#define CAN_BL_BAUDRATE_MODE 0
+
+
+#endif // USER_CODE_H
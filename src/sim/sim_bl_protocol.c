@@ -0,0 +1,51 @@
+/*----------------------------------------------------------------------------*/
+/**
+ * \file         sim_bl_protocol.c
+ * \brief        Host replacement for the S32K bootloader protocol hooks.
+ * \details      The CAN stack passes every received frame to the bootloader
+ *               protocol. The host simulation only counts these frames.
+ * \date         20261019
+ *
+ */
+/*----------------------------------------------------------------------------*/
+
+// ---------------------------------------------------------------------------------------------------
+// includes
+// ---------------------------------------------------------------------------------------------------
+#include "hal_can.h"
+#include "sfl_bl_protocol_s32k.h"
+
+// ---------------------------------------------------------------------------------------------------
+// module globals
+// ---------------------------------------------------------------------------------------------------
+uint32_t ext_sim_bl_rx_msg_cnt = 0u;
+
+// ---------------------------------------------------------------------------------------------------
+// functions
+// ---------------------------------------------------------------------------------------------------
+
+enum_SFL_BLP_ERROR_CODES sfl_bl_protocol_s32k_process_rx_msg(const struct_hal_can_frame* ptr_can_msg)
+{
+    (void)ptr_can_msg;
+    ext_sim_bl_rx_msg_cnt++;
+    return SFL_BLP_ERROR_NONE;
+}
+
+enum_SFL_BLP_ERROR_CODES sfl_bl_protocol_s32k_rx_tx_init(uint8_t rx_msg_box_num, uint8_t tx_msg_box_num)
+{
+    (void)rx_msg_box_num;
+    (void)tx_msg_box_num;
+    return SFL_BLP_ERROR_NONE;
+}
+
+enum_SFL_BLP_ERROR_CODES sfl_bl_protocol_s32k_set_baudrate(const struct_hal_can_handle* ptr_can_handle, uint8_t baudrate)
+{
+    (void)ptr_can_handle;
+    (void)baudrate;
+    return SFL_BLP_ERROR_NONE;
+}
+
+enum_SFL_BLP_ERROR_CODES sfl_bl_protocol_s32k_get_baudrate(void)
+{
+    return SFL_BLP_ERROR_NONE;
+}
@@ -0,0 +1,486 @@
+/*----------------------------------------------------------------------------*/
+/**
+ * \file         sim_can_bench.c
+ * \brief        Throughput benchmark of the CAN stack on the host simulation.
+ * \details      Replays CAN traffic into #sfl_can_db_rx_wrapper (the CAN ISR
+ *               path of can_app.c) and runs the CAN part of the super-loop
+ *               (#sfl_can_queue_in_process, #sfl_can_db_output_to_bus) with a
+ *               configurable loop period on virtual time.
+ *
+ *               Traffic is either read from a candump log file
+ *               ("(1436509052.249713) can0 18FF1234#0102030405060708") or
+ *               generated with a fixed rate per bus.
+ *
+ *               Reported per run:
+ *               - frames per second through the stack (host CPU time)
+ *               - cycles and nanoseconds per frame for the ISR part and the
+ *                 main-loop part
+ *               - RX/TX FIFO drop rate and the maximum RX FIFO fill level
+ *
+ *               Usage: sim_can_bench [-f candump.log] [-b bitrate] [-l foreign_load_pct]
+ *                                    [-p loop_period_us] [-r frames_per_s] [-d duration_ms]
+ *                                    [-n buses] [-u unknown_id_pct] [-s seed]
+ * \date         20261019
+ *
+ */
+/*----------------------------------------------------------------------------*/
+
+// ---------------------------------------------------------------------------------------------------
+// includes
+// ---------------------------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "hal_sim.h"
+#include "sfl_can_db.h"
+#include "sfl_fifo.h"
+#include "sfl_timer.h"
+
+// ---------------------------------------------------------------------------------------------------
+// defines
+// ---------------------------------------------------------------------------------------------------
+#define SIM_BENCH_TRACE_MAX         1000000u    ///< frames read from a log file
+#define SIM_BENCH_LINE_LEN          256u
+#define SIM_BENCH_INJECT_AHEAD_US   20000u      ///< frames are handed to the virtual bus this far ahead of time
+
+// ---------------------------------------------------------------------------------------------------
+// typedefs
+// ---------------------------------------------------------------------------------------------------
+typedef struct
+{
+    uint64_t    time_us;
+    uint8_t     bus_id;
+    uint8_t     dlc;
+    uint32_t    can_id;
+    uint8_t     data[HAL_SIM_CAN_PAYLOAD_MAX];
+} struct_sim_bench_frame;
+
+typedef struct
+{
+    const char* trace_file;
+    uint32_t    bitrate;
+    uint8_t     foreign_load_pct;
+    uint32_t    loop_period_us;
+    uint32_t    rate_fps;
+    uint32_t    duration_ms;
+    uint8_t     bus_cnt;
+    uint8_t     unknown_id_pct;
+    uint32_t    seed;
+} struct_sim_bench_cfg;
+
+typedef struct
+{
+    uint64_t cycles;
+    uint64_t ns;
+    uint64_t calls;
+} struct_sim_bench_meas;
+
+// ---------------------------------------------------------------------------------------------------
+// module globals
+// ---------------------------------------------------------------------------------------------------
+extern volatile const can_block_db_const_typ can_block_db_const[];
+extern volatile const can_bus_db_const_typ can_bus_db_const[];
+
+static struct_sim_bench_frame* mgl_trace = NULL;
+static uint32_t mgl_trace_cnt = 0u;
+
+static struct_sim_bench_meas mgl_meas_isr;
+static struct_sim_bench_meas mgl_meas_loop;
+static struct_sim_bench_meas mgl_meas_output;
+static uint64_t mgl_frames_to_db = 0u;
+static uint32_t mgl_rx_fifo_peak[CAN_BUS_MAX];
+
+// ---------------------------------------------------------------------------------------------------
+// measurement
+// ---------------------------------------------------------------------------------------------------
+
+static inline uint64_t sim_bench_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0u;
+#endif
+}
+
+static inline uint64_t sim_bench_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+static void sim_bench_rx_isr(uint8_t bus_id, const struct_hal_can_frame* ptr_can_msg)
+{
+    uint64_t t0 = sim_bench_ns();
+    uint64_t c0 = sim_bench_cycles();
+
+    sfl_can_db_rx_wrapper(bus_id, ptr_can_msg);
+
+    mgl_meas_isr.cycles += sim_bench_cycles() - c0;
+    mgl_meas_isr.ns += sim_bench_ns() - t0;
+    mgl_meas_isr.calls++;
+}
+
+static void sim_bench_can_msg_receive(uint8_t bus_id, bios_can_msg_typ* msg)
+{
+    (void)bus_id;
+    (void)msg;
+    mgl_frames_to_db++;
+}
+
+// ---------------------------------------------------------------------------------------------------
+// traffic
+// ---------------------------------------------------------------------------------------------------
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Reads a candump log. The bus index is the trailing number of the interface
+* name, IDs with more than 3 hex digits are extended IDs. Remote frames and
+* error frames are skipped.
+* \endinternal
+*/
+static uint32_t sim_bench_trace_load(const char* file_name)
+{
+    FILE* fp = fopen(file_name, "r");
+    char line[SIM_BENCH_LINE_LEN];
+    uint64_t first_us = 0u;
+
+    if (fp == NULL)
+    {
+        perror(file_name);
+        return 0u;
+    }
+
+    while ( (mgl_trace_cnt < SIM_BENCH_TRACE_MAX) && (fgets(line, sizeof(line), fp) != NULL) )
+    {
+        unsigned long sec, usec;
+        char ifname[32];
+        char frame[160];
+        char* ptr_hash;
+        char* ptr_data;
+        size_t id_len;
+        struct_sim_bench_frame* ptr_frame = &mgl_trace[mgl_trace_cnt];
+        size_t ifname_len;
+
+        if (sscanf(line, " (%lu.%lu) %31s %159s", &sec, &usec, ifname, frame) != 4)
+        {
+            continue;
+        }
+
+        ptr_hash = strchr(frame, '#');
+        if ( (ptr_hash == NULL) || (ptr_hash[1] == 'R') )
+        {
+            continue;
+        }
+
+        id_len = (size_t)(ptr_hash - frame);
+        *ptr_hash = '\0';
+        ptr_data = ptr_hash + 1;
+        if (*ptr_data == '#')
+        {
+            // CAN FD: flags nibble follows the second '#'
+            ptr_data += 2;
+        }
+
+        memset(ptr_frame, 0, sizeof(*ptr_frame));
+        ptr_frame->can_id = (uint32_t)strtoul(frame, NULL, 16);
+        if (id_len > 3u)
+        {
+            ptr_frame->can_id |= 0x80000000u;
+        }
+
+        ifname_len = strlen(ifname);
+        ptr_frame->bus_id = (ifname_len > 0u) ? (uint8_t)(ifname[ifname_len - 1u] - '0') : 0u;
+        if (ptr_frame->bus_id >= CAN_BUS_MAX)
+        {
+            ptr_frame->bus_id = 0u;
+        }
+
+        uint8_t len = 0u;
+        while ( (len < HAL_SIM_CAN_PAYLOAD_MAX) && (ptr_data[0] != '\0') && (ptr_data[1] != '\0') )
+        {
+            char byte_str[3] = {ptr_data[0], ptr_data[1], '\0'};
+            ptr_frame->data[len++] = (uint8_t)strtoul(byte_str, NULL, 16);
+            ptr_data += 2;
+        }
+        ptr_frame->dlc = hal_can_len_to_dlc(len);
+
+        ptr_frame->time_us = ((uint64_t)sec * 1000000u) + usec;
+        if (mgl_trace_cnt == 0u)
+        {
+            first_us = ptr_frame->time_us;
+        }
+        ptr_frame->time_us -= first_us;
+        mgl_trace_cnt++;
+    }
+
+    fclose(fp);
+    return mgl_trace_cnt;
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Generates rate_fps frames per second and bus. Known IDs are taken from the
+* RX blocks of the CAN DB of that bus, the rest are IDs the DB does not know
+* (they only reach the gateway for gateway inputs).
+* \endinternal
+*/
+static uint32_t sim_bench_trace_generate(const struct_sim_bench_cfg* ptr_cfg)
+{
+    uint32_t known_id[CAN_BLOCK_MAX + 1u];
+    uint8_t known_ext[CAN_BLOCK_MAX + 1u];
+    uint32_t known_cnt;
+    uint32_t i, blk;
+    uint8_t bus_id;
+    uint64_t period_us = (ptr_cfg->rate_fps > 0u) ? (1000000u / ptr_cfg->rate_fps) : 1000u;
+    uint64_t frames_per_bus = ((uint64_t)ptr_cfg->duration_ms * 1000u) / period_us;
+
+    srand(ptr_cfg->seed);
+
+    for (i = 0u; (i < frames_per_bus) && (mgl_trace_cnt < SIM_BENCH_TRACE_MAX); i++)
+    {
+        for (bus_id = 0u; (bus_id < ptr_cfg->bus_cnt) && (mgl_trace_cnt < SIM_BENCH_TRACE_MAX); bus_id++)
+        {
+            struct_sim_bench_frame* ptr_frame = &mgl_trace[mgl_trace_cnt];
+
+            known_cnt = 0u;
+            for (blk = 0u; blk < CAN_BLOCK_MAX; blk++)
+            {
+                if ( (can_block_db_const[blk].bus_id == bus_id) && (can_block_db_const[blk].tx == 0u) )
+                {
+                    known_id[known_cnt] = can_block_db_const[blk].can_id;
+                    known_ext[known_cnt] = can_block_db_const[blk].can_id_ext;
+                    known_cnt++;
+                }
+            }
+
+            memset(ptr_frame, 0, sizeof(*ptr_frame));
+            ptr_frame->time_us = i * period_us;
+            ptr_frame->bus_id = bus_id;
+            ptr_frame->dlc = 8u;
+
+            if ( (known_cnt > 0u) && ((uint32_t)(rand() % 100) >= ptr_cfg->unknown_id_pct) )
+            {
+                blk = (uint32_t)rand() % known_cnt;
+                ptr_frame->can_id = known_id[blk] | ((uint32_t)known_ext[blk] << 31);
+            }
+            else
+            {
+                ptr_frame->can_id = 0x600u + ((uint32_t)rand() % 0x100u);
+            }
+
+            for (blk = 0u; blk < 8u; blk++)
+            {
+                ptr_frame->data[blk] = (uint8_t)rand();
+            }
+            mgl_trace_cnt++;
+        }
+    }
+
+    return mgl_trace_cnt;
+}
+
+// ---------------------------------------------------------------------------------------------------
+// main
+// ---------------------------------------------------------------------------------------------------
+
+static void sim_bench_usage(const char* name)
+{
+    printf("usage: %s [-f candump.log] [-b bitrate] [-l foreign_load_pct] [-p loop_period_us]\n"
+           "          [-r frames_per_s] [-d duration_ms] [-n buses] [-u unknown_id_pct] [-s seed]\n", name);
+}
+
+int main(int argc, char** argv)
+{
+    struct_sim_bench_cfg cfg =
+    {
+        .trace_file         = NULL,
+        .bitrate            = 250000u,
+        .foreign_load_pct   = 0u,
+        .loop_period_us     = 1000u,
+        .rate_fps           = 1000u,
+        .duration_ms        = 10000u,
+        .bus_cnt            = CAN_BUS_MAX,
+        .unknown_id_pct     = 50u,
+        .seed               = 1u,
+    };
+    struct_hal_sim_can_bus_cfg bus_cfg;
+    uint32_t next_frame = 0u;
+    uint8_t bus_id;
+    int opt;
+
+    while ( (opt = getopt(argc, argv, "f:b:l:p:r:d:n:u:s:h")) != -1 )
+    {
+        switch (opt)
+        {
+            case 'f': cfg.trace_file = optarg; break;
+            case 'b': cfg.bitrate = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'l': cfg.foreign_load_pct = (uint8_t)strtoul(optarg, NULL, 0); break;
+            case 'p': cfg.loop_period_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'r': cfg.rate_fps = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'd': cfg.duration_ms = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'n': cfg.bus_cnt = (uint8_t)strtoul(optarg, NULL, 0); break;
+            case 'u': cfg.unknown_id_pct = (uint8_t)strtoul(optarg, NULL, 0); break;
+            case 's': cfg.seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+            default:
+                sim_bench_usage(argv[0]);
+                return (opt == 'h') ? 0 : 1;
+        }
+    }
+    if (cfg.bus_cnt > CAN_BUS_MAX)
+    {
+        cfg.bus_cnt = CAN_BUS_MAX;
+    }
+    if (cfg.loop_period_us == 0u)
+    {
+        cfg.loop_period_us = 1u;
+    }
+
+    // ----- init like main.c / can_app.c -----
+    hal_sim_reset();
+    bus_cfg.bitrate = cfg.bitrate;
+    bus_cfg.foreign_load_pct = cfg.foreign_load_pct;
+    bus_cfg.rx_latency_us = 2u;
+    for (bus_id = 0u; bus_id < CAN_BUS_MAX; bus_id++)
+    {
+        (void)hal_sim_can_configure(bus_id, &bus_cfg);
+    }
+    hal_sim_can_set_hooks(sim_bench_rx_isr, NULL);
+
+    sfl_can_db_tables_data_init();
+    sfl_can_db_fifo_init();
+    set_callback_can_msg_receive(sim_bench_can_msg_receive);
+    // inline time base as in main_timer_1ms of the firmware
+    set_callback_timer_1ms(sfl_timer_tick_1ms);
+
+    // ----- traffic -----
+    mgl_trace = calloc(SIM_BENCH_TRACE_MAX, sizeof(struct_sim_bench_frame));
+    if (mgl_trace == NULL)
+    {
+        perror("calloc");
+        return 1;
+    }
+    if (cfg.trace_file != NULL)
+    {
+        (void)sim_bench_trace_load(cfg.trace_file);
+    }
+    else
+    {
+        (void)sim_bench_trace_generate(&cfg);
+    }
+    if (mgl_trace_cnt == 0u)
+    {
+        printf("no frames to replay\n");
+        return 1;
+    }
+
+    // ----- super-loop on virtual time -----
+    for (;;)
+    {
+        uint32_t pending = 0u;
+        uint32_t queued = 0u;
+        uint64_t t0, c0;
+        uint64_t frames_before;
+
+        while ( (next_frame < mgl_trace_cnt) && (mgl_trace[next_frame].time_us < (hal_sim_time_get_us() + SIM_BENCH_INJECT_AHEAD_US)) )
+        {
+            struct_sim_bench_frame* ptr_frame = &mgl_trace[next_frame];
+            struct_hal_can_frame frame = {0};
+
+            frame.can_id = ptr_frame->can_id;
+            frame.can_dlc = ptr_frame->dlc;
+            frame.ptr_data = ptr_frame->data;
+            (void)hal_sim_can_inject(ptr_frame->bus_id, &frame, ptr_frame->time_us);
+            next_frame++;
+        }
+
+        hal_sim_time_advance_us(cfg.loop_period_us);
+        sfl_timer_epoch_update();
+
+        for (bus_id = 0u; bus_id < CAN_BUS_MAX; bus_id++)
+        {
+            uint32_t fill = sfl_fifo_get_count(can_fifo_config_actual[bus_id]->rx_fifo_config);
+            if (fill > mgl_rx_fifo_peak[bus_id])
+            {
+                mgl_rx_fifo_peak[bus_id] = fill;
+            }
+        }
+
+        frames_before = mgl_frames_to_db;
+        t0 = sim_bench_ns();
+        c0 = sim_bench_cycles();
+        sfl_can_queue_in_process();
+        if (mgl_frames_to_db != frames_before)
+        {
+            mgl_meas_loop.cycles += sim_bench_cycles() - c0;
+            mgl_meas_loop.ns += sim_bench_ns() - t0;
+            mgl_meas_loop.calls += mgl_frames_to_db - frames_before;
+        }
+
+        t0 = sim_bench_ns();
+        c0 = sim_bench_cycles();
+        sfl_can_db_output_to_bus();
+        mgl_meas_output.cycles += sim_bench_cycles() - c0;
+        mgl_meas_output.ns += sim_bench_ns() - t0;
+        mgl_meas_output.calls++;
+
+        for (bus_id = 0u; bus_id < CAN_BUS_MAX; bus_id++)
+        {
+            pending += hal_sim_can_get_pending(bus_id);
+            queued += sfl_fifo_get_count(can_fifo_config_actual[bus_id]->rx_fifo_config);
+        }
+        if ( (next_frame >= mgl_trace_cnt) && (pending == 0u) && (queued == 0u) )
+        {
+            break;
+        }
+    }
+
+    // ----- report -----
+    uint64_t stack_ns = mgl_meas_isr.ns + mgl_meas_loop.ns;
+    uint64_t sim_us = hal_sim_time_get_us();
+
+    printf("CAN stack host benchmark\n");
+    printf("  traffic            : %s, %u frames\n", (cfg.trace_file != NULL) ? cfg.trace_file : "generated", mgl_trace_cnt);
+    printf("  virtual bus        : %u bit/s, %u %% foreign load, loop period %u us\n", cfg.bitrate, cfg.foreign_load_pct, cfg.loop_period_us);
+    printf("  simulated time     : %.3f s\n", (double)sim_us / 1e6);
+    printf("  frames to CAN DB   : %llu of %llu received\n", (unsigned long long)mgl_frames_to_db, (unsigned long long)mgl_meas_isr.calls);
+    printf("  host throughput    : %.0f frames/s (ISR + queue processing)\n",
+           (stack_ns > 0u) ? ((double)mgl_frames_to_db * 1e9 / (double)stack_ns) : 0.0);
+    printf("  rx wrapper (ISR)   : %.1f cycles, %.1f ns per frame\n",
+           (mgl_meas_isr.calls > 0u) ? ((double)mgl_meas_isr.cycles / (double)mgl_meas_isr.calls) : 0.0,
+           (mgl_meas_isr.calls > 0u) ? ((double)mgl_meas_isr.ns / (double)mgl_meas_isr.calls) : 0.0);
+    printf("  queue in process   : %.1f cycles, %.1f ns per frame\n",
+           (mgl_meas_loop.calls > 0u) ? ((double)mgl_meas_loop.cycles / (double)mgl_meas_loop.calls) : 0.0,
+           (mgl_meas_loop.calls > 0u) ? ((double)mgl_meas_loop.ns / (double)mgl_meas_loop.calls) : 0.0);
+    printf("  output to bus      : %.1f cycles, %.1f ns per loop\n",
+           (mgl_meas_output.calls > 0u) ? ((double)mgl_meas_output.cycles / (double)mgl_meas_output.calls) : 0.0,
+           (mgl_meas_output.calls > 0u) ? ((double)mgl_meas_output.ns / (double)mgl_meas_output.calls) : 0.0);
+    printf("  critical sections  : %u\n", hal_sim_get_critical_section_count());
+
+    for (bus_id = 0u; bus_id < CAN_BUS_MAX; bus_id++)
+    {
+        struct_hal_sim_can_stats stats;
+        uint32_t rx_drop = sfl_can_db_get_fifo_overflow_count(bus_id, 0u);
+        uint32_t tx_drop = sfl_can_db_get_fifo_overflow_count(bus_id, 1u);
+
+        hal_sim_can_get_stats(bus_id, &stats);
+        printf("  bus %u: rx %u, rx fifo drop %u (%.2f %%), rx fifo peak %u/%u, tx %u, tx fifo drop %u, tx mb busy %u, wire load %.1f %%\n",
+               bus_id, stats.rx_delivered, rx_drop,
+               (stats.rx_delivered > 0u) ? (100.0 * rx_drop / stats.rx_delivered) : 0.0,
+               mgl_rx_fifo_peak[bus_id], sfl_can_db_get_fifo_size(bus_id, 0u),
+               stats.tx_sent, tx_drop, stats.tx_busy,
+               (sim_us > 0u) ? (100.0 * (double)stats.wire_busy_us / (double)sim_us) : 0.0);
+    }
+
+    free(mgl_trace);
+    return 0;
+}
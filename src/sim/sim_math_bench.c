@@ -0,0 +1,233 @@
+/*----------------------------------------------------------------------------*/
+/**
+ * \file         sim_math_bench.c
+ * \brief        Benchmark of the sfl_math lookup functions on the host.
+ * \details      Compares the linear scan lookups with the binary search, uniform
+ *               grid and prepared table variants for table sizes 3..64:
+ *               - os_util_lookup1D, os_util_lookup1D_bsearch, os_util_lut1D,
+ *                 os_util_lookup1D_uniform
+ *               - os_util_lookup1D_32, os_util_lookup1D_32_bsearch
+ *               - os_util_lookup2D, os_util_lookup2D_bsearch (size x size)
+ *
+ *               Every input is also checked: the binary search variants must
+ *               return the same value as the original functions, the uniform
+ *               grid and prepared table variants may differ by 1 (rounding).
+ *               The exit code is 1 if a check fails.
+ *
+ *               Reported per function and table size: nanoseconds per call.
+ *               The host CPU has a branch predictor and caches, so only the
+ *               ratio between the functions is meaningful for the S32K.
+ *
+ *               Usage: sim_math_bench [-n calls_per_size] [-s seed]
+ * \date         20261019
+ *
+ */
+/*----------------------------------------------------------------------------*/
+
+// ---------------------------------------------------------------------------------------------------
+// includes
+// ---------------------------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "sfl_math.h"
+
+// ---------------------------------------------------------------------------------------------------
+// defines
+// ---------------------------------------------------------------------------------------------------
+#define SIM_MATH_SIZE_MIN           3u
+#define SIM_MATH_SIZE_MAX           64u
+#define SIM_MATH_INPUTS             4096u       ///< random inputs per table, reused for all calls
+#define SIM_MATH_GRID_SHIFT         6u          ///< x distance of the uniform grid is 64
+
+// ---------------------------------------------------------------------------------------------------
+// module globals
+// ---------------------------------------------------------------------------------------------------
+static int16_t mgl_x16[SIM_MATH_SIZE_MAX];
+static int16_t mgl_y16[SIM_MATH_SIZE_MAX];
+static int32_t mgl_x32[SIM_MATH_SIZE_MAX];
+static int32_t mgl_y32[SIM_MATH_SIZE_MAX];
+static int16_t mgl_z16[SIM_MATH_SIZE_MAX * SIM_MATH_SIZE_MAX];
+static int32_t mgl_slope[SIM_MATH_SIZE_MAX];
+static int16_t mgl_in_x[SIM_MATH_INPUTS];
+static int16_t mgl_in_y[SIM_MATH_INPUTS];
+static volatile int32_t mgl_sink;              ///< keeps the compiler from removing the calls
+static uint32_t mgl_errors = 0u;
+
+// ---------------------------------------------------------------------------------------------------
+// helpers
+// ---------------------------------------------------------------------------------------------------
+
+static inline uint64_t sim_math_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+static void sim_math_usage(const char* name)
+{
+    printf("usage: %s [-n calls_per_size] [-s seed]\n", name);
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Uniform grid x = i * 2^SIM_MATH_GRID_SHIFT, so all variants can use the same
+* points. y is a monotonic curve with random steps like a sensor characteristic,
+* z is y[x] + y[y] / 2.
+* \endinternal
+*/
+static void sim_math_tables(uint16_t size)
+{
+    int32_t y = -2000 + (rand() % 1000);
+
+    for (uint16_t i = 0u; i < size; i++)
+    {
+        mgl_x16[i] = (int16_t)(i << SIM_MATH_GRID_SHIFT);
+        mgl_y16[i] = (int16_t)y;
+        mgl_x32[i] = mgl_x16[i];
+        mgl_y32[i] = mgl_y16[i];
+        y += rand() % 300;
+    }
+    for (uint16_t i = 0u; i < size; i++)
+    {
+        for (uint16_t k = 0u; k < size; k++)
+        {
+            mgl_z16[i * size + k] = (int16_t)(mgl_y16[k] + (mgl_y16[i] / 2));
+        }
+    }
+
+    // inputs cover the table and 10% on both sides for extrapolation
+    for (uint32_t n = 0u; n < SIM_MATH_INPUTS; n++)
+    {
+        const int32_t range = (int32_t)(size - 1u) << SIM_MATH_GRID_SHIFT;
+
+        mgl_in_x[n] = (int16_t)((rand() % (range + range / 5 + 1)) - range / 10);
+        mgl_in_y[n] = (int16_t)((rand() % (range + range / 5 + 1)) - range / 10);
+    }
+}
+
+static void sim_math_check(const char* name, uint16_t size, int16_t val, int32_t expected, int32_t result, int32_t tolerance)
+{
+    if ( (result > expected + tolerance) || (result < expected - tolerance) )
+    {
+        if (mgl_errors < 10u)
+        {
+            printf("MISMATCH %s size %u x %d: expected %ld, got %ld\n", name, size, val, (long)expected, (long)result);
+        }
+        mgl_errors++;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/**
+* \internal
+* Compares all variants with the originals for every input and mode.
+* \endinternal
+*/
+static void sim_math_verify(uint16_t size, const struct_lut1D* lut)
+{
+    for (uint32_t n = 0u; n < SIM_MATH_INPUTS; n++)
+    {
+        const int16_t val = mgl_in_x[n];
+
+        for (uint8_t mode = 0u; mode < LUT_MODE_MAX; mode++)
+        {
+            const int16_t ref16 = os_util_lookup1D(mgl_x16, mgl_y16, size, val, (enum_LUT_MODE)mode);
+            const int32_t ref32 = os_util_lookup1D_32(mgl_x32, mgl_y32, size, val, (enum_LUT_MODE)mode);
+
+            sim_math_check("lookup1D_bsearch", size, val, ref16, os_util_lookup1D_bsearch(mgl_x16, mgl_y16, size, val, (enum_LUT_MODE)mode), 0);
+            sim_math_check("lookup1D_32_bsearch", size, val, ref32, os_util_lookup1D_32_bsearch(mgl_x32, mgl_y32, size, val, (enum_LUT_MODE)mode), 0);
+
+            // LUT_MODE_LIMIT of os_util_lookup1D only limits below the table
+            if ( (mode != LUT_MODE_LIMIT) || (val <= mgl_x16[size - 1u]) )
+            {
+                sim_math_check("lut1D", size, val, ref16, os_util_lut1D(lut, val, (enum_LUT_MODE)mode), 1);
+                sim_math_check("lookup1D_uniform", size, val, ref16, os_util_lookup1D_uniform(mgl_y16, size, 0, SIM_MATH_GRID_SHIFT, val, (enum_LUT_MODE)mode), 1);
+            }
+        }
+
+        if (size <= UINT8_MAX)
+        {
+            sim_math_check("lookup2D_bsearch", size, val,
+                           os_util_lookup2D(mgl_x16, mgl_x16, (uint8_t)size, (uint8_t)size, mgl_z16, val, mgl_in_y[n]),
+                           os_util_lookup2D_bsearch(mgl_x16, mgl_x16, (uint8_t)size, (uint8_t)size, mgl_z16, val, mgl_in_y[n]), 0);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------
+// main
+// ---------------------------------------------------------------------------------------------------
+
+#define SIM_MATH_MEASURE(result, calls, expr)                                   \
+    do                                                                          \
+    {                                                                           \
+        uint64_t t0_ = sim_math_ns();                                           \
+        for (uint32_t n_ = 0u; n_ < (calls); n_++)                              \
+        {                                                                       \
+            const int16_t val = mgl_in_x[n_ % SIM_MATH_INPUTS];                 \
+            const int16_t val_y = mgl_in_y[n_ % SIM_MATH_INPUTS];               \
+            (void)val_y;                                                        \
+            mgl_sink += (expr);                                                 \
+        }                                                                       \
+        (result) = (double)(sim_math_ns() - t0_) / (double)(calls);             \
+    } while (0)
+
+int main(int argc, char** argv)
+{
+    uint32_t calls = 1000000u;
+    uint32_t seed = 1u;
+    int opt;
+
+    while ( (opt = getopt(argc, argv, "n:s:h")) != -1 )
+    {
+        switch (opt)
+        {
+            case 'n': calls = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 's': seed = (uint32_t)strtoul(optarg, NULL, 0); break;
+            default:
+                sim_math_usage(argv[0]);
+                return (opt == 'h') ? 0 : 1;
+        }
+    }
+    srand(seed);
+
+    printf("ns per call, %lu calls per size\n", (unsigned long)calls);
+    printf("size | 1D     | 1D_bs  | lut1D  | unif.  | 1D_32  | 32_bs  | 2D     | 2D_bs\n");
+    printf("-----|--------|--------|--------|--------|--------|--------|--------|--------\n");
+
+    for (uint16_t size = SIM_MATH_SIZE_MIN; size <= SIM_MATH_SIZE_MAX; size = (size < 8u) ? (size + 1u) : (uint16_t)(size * 2u))
+    {
+        struct_lut1D lut;
+        double t[8];
+
+        sim_math_tables(size);
+        if (os_util_lut1D_prepare(&lut, mgl_x16, mgl_y16, size, mgl_slope) == FALSE)
+        {
+            printf("os_util_lut1D_prepare failed for size %u\n", size);
+            return 1;
+        }
+        sim_math_verify(size, &lut);
+
+        SIM_MATH_MEASURE(t[0], calls, os_util_lookup1D(mgl_x16, mgl_y16, size, val, LUT_MODE_EXTRAPOLATION));
+        SIM_MATH_MEASURE(t[1], calls, os_util_lookup1D_bsearch(mgl_x16, mgl_y16, size, val, LUT_MODE_EXTRAPOLATION));
+        SIM_MATH_MEASURE(t[2], calls, os_util_lut1D(&lut, val, LUT_MODE_EXTRAPOLATION));
+        SIM_MATH_MEASURE(t[3], calls, os_util_lookup1D_uniform(mgl_y16, size, 0, SIM_MATH_GRID_SHIFT, val, LUT_MODE_EXTRAPOLATION));
+        SIM_MATH_MEASURE(t[4], calls, os_util_lookup1D_32(mgl_x32, mgl_y32, size, val, LUT_MODE_EXTRAPOLATION));
+        SIM_MATH_MEASURE(t[5], calls, os_util_lookup1D_32_bsearch(mgl_x32, mgl_y32, size, val, LUT_MODE_EXTRAPOLATION));
+        SIM_MATH_MEASURE(t[6], calls, os_util_lookup2D(mgl_x16, mgl_x16, (uint8_t)size, (uint8_t)size, mgl_z16, val, val_y));
+        SIM_MATH_MEASURE(t[7], calls, os_util_lookup2D_bsearch(mgl_x16, mgl_x16, (uint8_t)size, (uint8_t)size, mgl_z16, val, val_y));
+
+        printf("%4u | %6.1f | %6.1f | %6.1f | %6.1f | %6.1f | %6.1f | %6.1f | %6.1f\n",
+               size, t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7]);
+    }
+
+    printf("checks: %s (%lu mismatches)\n", (mgl_errors == 0u) ? "ok" : "FAILED", (unsigned long)mgl_errors);
+
+    return (mgl_errors == 0u) ? 0 : 1;
+}